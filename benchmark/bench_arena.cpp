@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdio>
+#include "allocator/arena.hpp"
+#include "container/deque.hpp"
+#include "container/list.hpp"
+#include "container/vector.hpp"
+
+/**
+ * @brief 内存区基准：模拟请求处理，每个请求构造若干 vector、list、deque 后整体丢弃，
+ *        对比二级配置器 alloc 与作用域内存区 arena_alloc 的吞吐
+ */
+namespace
+{
+    constexpr int REQUESTS = 20000;
+
+    template <typename Alloc>
+    long handle_request(const int id)
+    {
+        Tiny::vector<int, Alloc> ids;
+        Tiny::list<long, Alloc> events;
+        Tiny::deque<int, Alloc> pending(0, 0);
+        for (int i = 0; i < 200; ++i)
+        {
+            ids.push_back(id + i);
+            events.push_back(i * 3L);
+            pending.push_back(i);
+        }
+        long sum = 0;
+        for (auto x : ids)
+            sum += x;
+        for (auto x : events)
+            sum += x;
+        return sum + pending.size();
+    }
+
+    template <typename Run>
+    void measure(const char* name, Run run)
+    {
+        long checksum = 0;
+        const auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < REQUESTS; ++i)
+            checksum += run(i);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        std::printf("%-28s %8.1f krequest/s   (checksum %ld)\n", name,
+                    REQUESTS / elapsed.count() / 1e3, checksum);
+    }
+}
+
+int main()
+{
+    measure("alloc", [](const int id) { return handle_request<Tiny::alloc>(id); });
+
+    Tiny::arena request_arena;
+    measure("scoped arena_alloc", [&request_arena](const int id)
+    {
+        Tiny::scoped_arena<Tiny::arena_alloc<>> scope(request_arena);
+        return handle_request<Tiny::arena_alloc<>>(id);
+    });
+    std::printf("arena capacity after run: %zu B\n", request_arena.capacity());
+    return 0;
+}
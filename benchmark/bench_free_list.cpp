@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "allocator/free_list.hpp"
+
+/**
+ * @brief 中心自由链表竞争基准：多个线程反复批量弹出、再整段压回同一条链表，
+ *        模拟线程缓存与中心池之间的 refill/release 交换，对比无锁与互斥锁两种实现
+ */
+namespace
+{
+    struct Node
+    {
+        Node* free_list_link;
+    };
+
+    constexpr int NODES_PER_THREAD = 4096;
+    constexpr int ITERATIONS = 200000;
+    constexpr size_t BATCH = 8;
+
+    template <typename List>
+    double run(const unsigned thread_num)
+    {
+        std::vector<Node> nodes(thread_num * NODES_PER_THREAD);
+        List list;
+        for (auto& node : nodes)
+            list.push(&node, &node);
+
+        std::vector<std::thread> workers;
+        const auto begin = std::chrono::steady_clock::now();
+        for (unsigned t = 0; t < thread_num; ++t)
+        {
+            workers.emplace_back([&list]()
+            {
+                for (int i = 0; i < ITERATIONS; ++i)
+                {
+                    size_t count = 0;
+                    Node* chain = list.pop(BATCH, count);
+                    if (nullptr == chain)
+                        continue;
+                    Node* tail = chain;
+                    while (nullptr != tail->free_list_link)
+                        tail = tail->free_list_link;
+                    list.push(chain, tail);
+                }
+            });
+        }
+        for (auto& w : workers)
+            w.join();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        return thread_num * static_cast<double>(ITERATIONS) / elapsed.count() / 1e6;
+    }
+}
+
+int main()
+{
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("%8s %20s %20s\n", "threads", "lock-free (Mop/s)", "mutex (Mop/s)");
+    for (unsigned n = 1; n <= max_threads; n *= 2)
+    {
+        const double lock_free = run<Tiny::lock_free_free_list<Node>>(n);
+        const double locked = run<Tiny::locked_free_list<Node>>(n);
+        std::printf("%8u %20.2f %20.2f\n", n, lock_free, locked);
+    }
+    return 0;
+}
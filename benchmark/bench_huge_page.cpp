@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "allocator/allocator.hpp"
+#include "container/list.hpp"
+
+/**
+ * @brief 大页基准：构造数百万节点的 list，按随机顺序重新串接，使遍历时的访存跨越大量页面，
+ *        对比 malloc 区块与透明大页区块下的遍历耗时
+ */
+namespace
+{
+    constexpr size_t NODES = 4 * 1024 * 1024;
+    constexpr int PASSES = 5;
+
+    template <typename Pool>
+    void run(const char* name)
+    {
+        Tiny::list<long, Pool> nodes;
+        for (size_t i = 0; i < NODES; ++i)
+            nodes.push_back(static_cast<long>(i));
+
+        // 打乱链接顺序：节点在内存中仍然连续，但遍历顺序随机
+        std::vector<typename Tiny::list<long, Pool>::iterator> order;
+        order.reserve(NODES);
+        for (auto it = nodes.begin(); it != nodes.end(); ++it)
+            order.push_back(it);
+        std::shuffle(order.begin(), order.end(), std::mt19937_64(1));
+        for (auto it : order)
+            nodes.splice(nodes.end(), nodes, it);
+
+        long sum = 0;
+        const auto begin = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < PASSES; ++pass)
+        {
+            for (auto x : nodes)
+                sum += x;
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+        const auto s = Pool::stats();
+        std::printf("%-12s %7.2f ns/node   chunks: %zu total, %zu mmap, %zu huge page   (sum %ld)\n", name,
+                    elapsed.count() * 1e9 / (static_cast<double>(NODES) * PASSES),
+                    s.chunk_allocs, s.mmap_chunks, s.huge_page_chunks, sum);
+    }
+}
+
+int main()
+{
+    run<Tiny::default_alloc_template<false, 20, Tiny::default_size_classes, Tiny::malloc_chunk_source>>("malloc");
+    run<Tiny::default_alloc_template<false, 21, Tiny::default_size_classes, Tiny::huge_page_chunk_source>>(
+        "huge page");
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <vector>
+#include "allocator/allocator.hpp"
+#include "container/list.hpp"
+
+/**
+ * @brief 批量节点分配基准：构建数百万节点的 list，逐个 push_back（每个节点单独调用分配器）
+ *        对比 list(n, value) 与范围插入（按批整段取出节点），释放走 clear() 的批量归还
+ */
+namespace
+{
+    constexpr size_t NODES = 4000000;
+    constexpr int ROUNDS = 5;
+
+    template <typename F>
+    double best_of(F&& f)
+    {
+        double best = 1e9;
+        for (int r = 0; r < ROUNDS; ++r)
+        {
+            const auto begin = std::chrono::steady_clock::now();
+            f();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    template <typename Alloc>
+    void run(const char* name, const std::vector<long>& src)
+    {
+        // 预热：内存池先扩到能容纳全部节点，各组测得的是稳态下取还节点的开销
+        {
+            Tiny::list<long, Alloc> warm(NODES, 0L);
+        }
+        const double one_by_one = best_of([]
+        {
+            Tiny::list<long, Alloc> l;
+            for (size_t i = 0; i < NODES; ++i)
+                l.push_back(static_cast<long>(i));
+        });
+        const double filled = best_of([]
+        {
+            Tiny::list<long, Alloc> l(NODES, 1L);
+        });
+        const double ranged = best_of([&src]
+        {
+            Tiny::list<long, Alloc> l(src.begin(), src.end());
+        });
+        std::printf("%-10s push_back %7.2f ms   list(n, v) %7.2f ms (x%.2f)   list(first, last) %7.2f ms (x%.2f)\n", name,
+                    one_by_one * 1e3, filled * 1e3, one_by_one / filled, ranged * 1e3, one_by_one / ranged);
+    }
+}
+
+int main()
+{
+    std::vector<long> src(NODES);
+    for (size_t i = 0; i < NODES; ++i)
+        src[i] = static_cast<long>(i);
+
+    std::printf("%zu nodes, best of %d\n", NODES, ROUNDS);
+    run<Tiny::alloc>("alloc", src);
+    run<Tiny::mt_alloc>("mt_alloc", src);
+
+    const double std_list = best_of([&src]
+    {
+        std::list<long> l(src.begin(), src.end());
+    });
+    std::printf("%-10s list(first, last) %7.2f ms\n", "std::list", std_list * 1e3);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "allocator/allocator.hpp"
+#include "allocator/object_pool.hpp"
+
+/**
+ * @brief 对象池基准：请求对象在请求间反复创建与销毁，对比 new/delete、simple_alloc<T, mt_alloc>
+ *        与 object_pool<T>；另测保留构造状态时省去的构造与缓冲区重新分配
+ */
+namespace
+{
+    struct Request
+    {
+        Request() { body.reserve(512); }
+
+        explicit Request(const int id) : id(id) { body.reserve(512); }
+
+        int id = 0;
+        int status = 0;
+        char header[48] = {};
+        std::string body;
+    };
+
+    constexpr int INFLIGHT = 64;
+    constexpr int OPERATIONS = 2000000;
+    constexpr int ROUNDS = 5;
+
+    /** 每个线程维持 INFLIGHT 个在途请求，轮流销毁最旧的一个并创建新的 */
+    template <typename Create, typename Destroy>
+    double run(const int threads, Create create, Destroy destroy)
+    {
+        double best = 1e9;
+        for (int r = 0; r < ROUNDS; ++r)
+        {
+            std::vector<std::thread> workers;
+            const auto begin = std::chrono::steady_clock::now();
+            for (int t = 0; t < threads; ++t)
+            {
+                workers.emplace_back([&]
+                {
+                    Request* inflight[INFLIGHT] = {};
+                    for (int i = 0; i < OPERATIONS / threads; ++i)
+                    {
+                        Request*& slot = inflight[i % INFLIGHT];
+                        if (nullptr != slot)
+                            destroy(slot);
+                        slot = create(i);
+                        slot->body.assign("payload");
+                    }
+                    for (auto p : inflight)
+                    {
+                        if (nullptr != p)
+                            destroy(p);
+                    }
+                });
+            }
+            for (auto& w : workers)
+                w.join();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    void report(const int threads)
+    {
+        using Alloc = Tiny::simple_alloc<Request, Tiny::mt_alloc>;
+        using Pool = Tiny::object_pool<Request>;
+        using KeepPool = Tiny::object_pool<Request, true>;
+
+        const double heap = run(threads, [](int i) { return new Request(i); }, [](Request* p) { delete p; });
+        const double simple = run(threads, [](const int i)
+        {
+            Request* p = Alloc::allocate();
+            Tiny::construct(p, i);
+            return p;
+        }, [](Request* p)
+        {
+            Tiny::destroy(p);
+            Alloc::deallocate(p);
+        });
+        const double pool = run(threads, [](const int i) { return Pool::create(i); }, [](Request* p) { Pool::destroy(p); });
+        const double keep = run(threads, [](const int i)
+        {
+            Request* p = KeepPool::create(i);
+            p->id = i;
+            p->body.clear();
+            return p;
+        }, [](Request* p) { KeepPool::destroy(p); });
+
+        std::printf("%d thread(s): new/delete %7.2f ms   simple_alloc %7.2f ms   object_pool %7.2f ms   "
+                    "keep-constructed %7.2f ms\n", threads, heap * 1e3, simple * 1e3, pool * 1e3, keep * 1e3);
+    }
+}
+
+int main()
+{
+    std::printf("%d create/destroy pairs, %d in flight per thread, best of %d\n", OPERATIONS, INFLIGHT, ROUNDS);
+    report(1);
+    report(4);
+
+    const auto st = Tiny::object_pool<Request>::stats();
+    std::printf("object_pool<Request>: %zu creates, %zu refills, %zu chunks, %zu bytes held\n", st.allocations[0],
+                st.refills, st.chunk_allocs, st.heap_size);
+    return 0;
+}
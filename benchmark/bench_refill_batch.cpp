@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "allocator/allocator.hpp"
+
+/**
+ * @brief 补充批量基准：按 Zipf 分布在 16 个默认类别上生成请求（指数越大越偏向少数热门尺寸），
+ *        维持固定数量的存活对象并随机替换，观察慢启动批量下的补充次数、从系统申请的字节数与空闲字节数
+ */
+namespace
+{
+    constexpr size_t LIVE_OBJECTS = 4096;
+    constexpr size_t OPERATIONS = 4000000;
+
+    std::vector<size_t> make_sizes(const double skew)
+    {
+        std::vector<double> weights(Tiny::NFREELISTS);
+        for (size_t i = 0; i < weights.size(); ++i)
+            weights[i] = 1.0 / std::pow(static_cast<double>(i + 1), skew);
+        std::mt19937_64 rng(7);
+        std::discrete_distribution<size_t> rank(weights.begin(), weights.end());
+        std::vector<size_t> sizes(OPERATIONS);
+        for (auto& n : sizes)
+            n = (rank(rng) * 5 % Tiny::NFREELISTS + 1) * Tiny::ALIGN; // 打散热门类别，避免总是最小尺寸
+        return sizes;
+    }
+
+    template <typename Alloc>
+    void run(const double skew)
+    {
+        const auto sizes = make_sizes(skew);
+        std::vector<std::pair<void*, size_t>> live(LIVE_OBJECTS, {nullptr, 0});
+        const auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            auto& slot = live[(i * 7919) % LIVE_OBJECTS];
+            if (nullptr != slot.first)
+                Alloc::deallocate(slot.first, slot.second);
+            slot = {Alloc::allocate(sizes[i]), sizes[i]};
+            *static_cast<char*>(slot.first) = 1;
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        size_t live_bytes = 0;
+        for (auto [p, n] : live)
+            live_bytes += n;
+
+        const auto s = Alloc::stats();
+        std::printf("zipf %.1f   refills %8zu   heap %8zu B   live %8zu B   idle %8zu B   %7.2f Mop/s\n",
+                    skew, s.refills, s.heap_size, live_bytes, s.free_list_bytes + s.thread_cache_bytes + s.pool_bytes,
+                    static_cast<double>(sizes.size()) / elapsed.count() / 1e6);
+        for (auto [p, n] : live)
+            Alloc::deallocate(p, n);
+    }
+}
+
+int main()
+{
+    // 每种分布使用独立的分配器实例，统计互不干扰
+    run<Tiny::default_alloc_template<false, 10>>(0.0);
+    run<Tiny::default_alloc_template<false, 11>>(1.0);
+    run<Tiny::default_alloc_template<false, 12>>(2.0);
+    run<Tiny::default_alloc_template<false, 13>>(3.0);
+    return 0;
+}
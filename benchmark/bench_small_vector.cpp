@@ -0,0 +1,64 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "container/small_vector.hpp"
+#include "container/vector.hpp"
+
+/**
+ * @brief small_vector 基准：模拟每个请求构造一个短小的 vector、写入若干元素后丢弃，
+ *        对比 Tiny::vector、small_vector<int, 8> 与 std::vector 的耗时和二级配置器的分配次数
+ *        （std::vector 使用 operator new，不计入分配次数）
+ */
+namespace
+{
+    constexpr int REQUESTS = 2000000;
+    constexpr int ROUNDS = 5;
+
+    size_t pool_allocations()
+    {
+        const auto st = Tiny::alloc::stats();
+        size_t total = st.large_allocations;
+        for (const size_t n : st.allocations)
+            total += n;
+        return total;
+    }
+
+    template <typename Vector>
+    void run(const char* name, const int elements)
+    {
+        double best = 1e9;
+        size_t allocations = 0;
+        long checksum = 0;
+        for (int r = 0; r < ROUNDS; ++r)
+        {
+            const size_t before = pool_allocations();
+            const auto begin = std::chrono::steady_clock::now();
+            for (int i = 0; i < REQUESTS; ++i)
+            {
+                Vector v;
+                for (int j = 0; j < elements; ++j)
+                    v.push_back(i + j);
+                checksum += v[v.size() - 1];
+            }
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+            best = std::min(best, elapsed.count());
+            allocations = pool_allocations() - before;
+        }
+        std::printf("%-20s %2d elements %8.2f ms %6.1f ns/request   pool allocations per round: %zu   (%ld)\n", name,
+                    elements, best * 1e3, best * 1e9 / REQUESTS, allocations, checksum);
+    }
+}
+
+int main()
+{
+    std::printf("%d short-lived vectors per round, best of %d\n", REQUESTS, ROUNDS);
+    for (const int elements : {1, 4, 8, 16})
+    {
+        run<Tiny::vector<int>>("Tiny::vector", elements);
+        run<Tiny::small_vector<int, 8>>("small_vector<int, 8>", elements);
+        run<std::vector<int>>("std::vector", elements);
+    }
+    if (!Tiny::alloc_stats_enabled)
+        std::printf("allocation counts need TINY_STL_ALLOC_STATS\n");
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <cstdio>
+#include <utility>
+#include "allocator/allocator.hpp"
+#include "container/vector.hpp"
+
+/**
+ * @brief 类型萃取基准：用户自定义的 POD 结构体与 std::pair<int, int> 在未初始化拷贝、填充、
+ *        范围析构与 vector 扩容中的耗时，对比显式特化为“非平凡”的同布局类型（即旧版萃取的行为）
+ */
+namespace
+{
+    constexpr size_t COUNT = 1 << 20;
+    constexpr int ROUNDS = 50;
+
+    struct Particle
+    {
+        float x;
+        float y;
+        float z;
+        int id;
+    };
+
+    /** 与 Particle 布局相同，萃取结果被特化为全部非平凡 */
+    struct SlowParticle
+    {
+        float x;
+        float y;
+        float z;
+        int id;
+    };
+
+    struct SlowPair
+    {
+        std::pair<int, int> value;
+    };
+}
+
+namespace Tiny
+{
+    template <>
+    struct type_traits<SlowParticle>
+    {
+        typedef false_type has_trivial_default_constructor;
+        typedef false_type has_trivial_copy_constructor;
+        typedef false_type has_trivial_assignment_constructor;
+        typedef false_type has_trivial_destructor;
+        typedef false_type is_POD_type;
+    };
+
+    template <>
+    struct type_traits<SlowPair>
+    {
+        typedef false_type has_trivial_default_constructor;
+        typedef false_type has_trivial_copy_constructor;
+        typedef false_type has_trivial_assignment_constructor;
+        typedef false_type has_trivial_destructor;
+        typedef false_type is_POD_type;
+    };
+}
+
+namespace
+{
+    template <typename T>
+    void run(const char* name, const T& value)
+    {
+        using Alloc = Tiny::simple_alloc<T, Tiny::alloc>;
+        // 每项连续测两遍只报告第二遍：大块内存与已映射页面的复用状态与测试顺序无关
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            T* src = Alloc::allocate(COUNT);
+            T* dst = Alloc::allocate(COUNT);
+            Tiny::uninitialized_fill_n(src, COUNT, value);
+
+            const auto begin = std::chrono::steady_clock::now();
+            for (int round = 0; round < ROUNDS; ++round)
+            {
+                Tiny::uninitialized_copy(src, src + COUNT, dst);
+                Tiny::destroy(dst, dst + COUNT);
+                Tiny::uninitialized_fill(dst, dst + COUNT, value);
+                Tiny::destroy(dst, dst + COUNT);
+            }
+            const std::chrono::duration<double> primitives = std::chrono::steady_clock::now() - begin;
+
+            const auto grow_begin = std::chrono::steady_clock::now();
+            size_t total = 0;
+            for (int round = 0; round < ROUNDS / 10; ++round)
+            {
+                Tiny::vector<T> v(COUNT / 4, value);
+                v.insert(v.begin() + 1, COUNT, value);
+                total += v.size();
+            }
+            const std::chrono::duration<double> vectors = std::chrono::steady_clock::now() - grow_begin;
+
+            Tiny::destroy(src, src + COUNT);
+            Alloc::deallocate(src, COUNT);
+            Alloc::deallocate(dst, COUNT);
+            if (1 == pass)
+                std::printf("%-22s copy+fill+destroy %7.3f ns/elem   vector fill+insert %7.3f ns/elem   (%zu)\n", name,
+                            primitives.count() * 1e9 / (static_cast<double>(COUNT) * ROUNDS),
+                            vectors.count() * 1e9 / static_cast<double>(total), total);
+        }
+    }
+}
+
+int main()
+{
+    run("Particle", Particle{1, 2, 3, 4});
+    run("Particle (non-trivial)", SlowParticle{1, 2, 3, 4});
+    run("pair<int, int>", std::pair<int, int>(1, 2));
+    run("pair (non-trivial)", SlowPair{{1, 2}});
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "container/vector.hpp"
+
+/**
+ * @brief I/O 缓冲区准备基准：分配 n 字节的 vector<uint8_t> 后立即整体覆盖（以 memset 模拟 read() 写入），
+ *        对比值初始化的 vector(n)、resize_default_init、reserve_and_write 与 std::vector(n)
+ *
+ * 用法：bench_vector_default_init [缓冲区 MB]
+ */
+namespace
+{
+    constexpr int ROUNDS = 5;
+
+    /** 模拟 read(fd, p, n)：整段写入并返回写入的字节数 */
+    size_t fake_read(uint8_t* p, const size_t n)
+    {
+        std::memset(p, 0x5a, n);
+        return n;
+    }
+
+    template <typename F>
+    void run(const char* name, const size_t bytes, F&& f)
+    {
+        double best = 1e9;
+        unsigned checksum = 0;
+        for (int r = 0; r < ROUNDS; ++r)
+        {
+            const auto begin = std::chrono::steady_clock::now();
+            checksum += f(bytes);
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+            best = std::min(best, elapsed.count());
+        }
+        std::printf("%-24s %8.2f ms %7.2f GB/s   (%u)\n", name, best * 1e3,
+                    static_cast<double>(bytes) / best / 1e9, checksum);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+    const size_t bytes = mb * 1024 * 1024;
+    std::printf("%zu MB buffer, allocate then overwrite, best of %d\n", mb, ROUNDS);
+
+    run("vector(n)", bytes, [](const size_t n)
+    {
+        Tiny::vector<uint8_t> buffer(n);
+        fake_read(&buffer[0], n);
+        return buffer[n - 1];
+    });
+    run("resize_default_init", bytes, [](const size_t n)
+    {
+        Tiny::vector<uint8_t> buffer;
+        buffer.resize_default_init(n);
+        fake_read(&buffer[0], n);
+        return buffer[n - 1];
+    });
+    run("reserve_and_write", bytes, [](const size_t n)
+    {
+        Tiny::vector<uint8_t> buffer;
+        buffer.reserve_and_write(n, fake_read);
+        return buffer[n - 1];
+    });
+    run("std::vector(n)", bytes, [](const size_t n)
+    {
+        std::vector<uint8_t> buffer(n);
+        fake_read(buffer.data(), n);
+        return buffer[n - 1];
+    });
+    return 0;
+}
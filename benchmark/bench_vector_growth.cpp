@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "container/vector.hpp"
+
+/**
+ * @brief vector 扩容基准：不预留容量、连续 push_back 直到元素总字节数达到上限（默认 1 GB），
+ *        对比可按字节搬迁的类型走 reallocate 与强制走“分配-拷贝-析构-释放”的耗时；
+ *        另对比各扩容策略在拷贝路径下的耗时、最终容量与扩容瞬间新旧空间同时存在的峰值
+ *
+ * 用法：bench_vector_growth [上限 MB]
+ */
+namespace
+{
+    struct Point
+    {
+        double x;
+        double y;
+        int id;
+    };
+
+    /** 与 int / Point 布局相同，但声明为不可按字节搬迁，强制使用原来的扩容路径 */
+    struct copied_int
+    {
+        int value;
+    };
+
+    struct copied_point
+    {
+        Point value;
+    };
+}
+
+namespace Tiny
+{
+    template <>
+    struct is_trivially_relocatable<copied_int> : std::false_type
+    {
+    };
+
+    template <>
+    struct is_trivially_relocatable<copied_point> : std::false_type
+    {
+    };
+}
+
+namespace
+{
+    template <typename Vector, typename Make>
+    void run(const char* name, const size_t bytes, Make make)
+    {
+        const size_t count = bytes / sizeof(typename Vector::value_type);
+        const auto realloc_before = Tiny::malloc_alloc::stats().reallocations;
+        const auto begin = std::chrono::steady_clock::now();
+        long checksum = 0;
+        {
+            Vector v;
+            for (size_t i = 0; i < count; ++i)
+                v.push_back(make(i));
+            checksum = static_cast<long>(v.size());
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        std::printf("%-22s %8.2f ms %7.2f ns/push   realloc calls: %zu   (size %ld)\n", name,
+                    elapsed.count() * 1e3, elapsed.count() * 1e9 / static_cast<double>(count),
+                    Tiny::malloc_alloc::stats().reallocations - realloc_before, checksum);
+    }
+
+    /** 拷贝路径下扩容瞬间新旧两块空间同时存在，峰值为二者之和 */
+    template <typename Growth>
+    void run_policy(const char* name, const size_t bytes)
+    {
+        const size_t count = bytes / sizeof(copied_int);
+        const auto begin = std::chrono::steady_clock::now();
+        size_t peak = 0;
+        size_t capacity = 0;
+        {
+            Tiny::vector<copied_int, Tiny::alloc, Growth> v;
+            for (size_t i = 0; i < count; ++i)
+            {
+                v.push_back(copied_int{static_cast<int>(i)});
+                if (v.capacity() != capacity)
+                {
+                    peak = std::max(peak, (capacity + v.capacity()) * sizeof(copied_int));
+                    capacity = v.capacity();
+                }
+            }
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        std::printf("%-22s %8.2f ms   final capacity %7.1f MB   peak during growth %7.1f MB\n", name,
+                    elapsed.count() * 1e3, static_cast<double>(capacity * sizeof(copied_int)) / (1 << 20),
+                    static_cast<double>(peak) / (1 << 20));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    const size_t bytes = mb * 1024 * 1024;
+    std::printf("push_back up to %zu MB\n", mb);
+
+    run<Tiny::vector<int>>("int reallocate", bytes, [](const size_t i) { return static_cast<int>(i); });
+    run<Tiny::vector<copied_int>>("int copy", bytes, [](const size_t i) { return copied_int{static_cast<int>(i)}; });
+    run<std::vector<int>>("int std::vector", bytes, [](const size_t i) { return static_cast<int>(i); });
+
+    const auto point = [](const size_t i) { return Point{i * 0.5, i * 2.0, static_cast<int>(i)}; };
+    run<Tiny::vector<Point>>("Point reallocate", bytes, point);
+    run<Tiny::vector<copied_point>>("Point copy", bytes, [&point](const size_t i) { return copied_point{point(i)}; });
+    run<std::vector<Point>>("Point std::vector", bytes, point);
+
+    std::printf("\ngrowth policies, int copy path\n");
+    run_policy<Tiny::growth_2x>("2x", bytes);
+    run_policy<Tiny::growth_1_5x>("1.5x", bytes);
+    run_policy<Tiny::page_growth<>>("1.5x page-rounded", bytes);
+    run_policy<Tiny::huge_page_growth<>>("1.5x huge-page-rounded", bytes);
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "container/vector.hpp"
+
+/**
+ * @brief vector 移动语义基准：以超出短字符串优化长度的 std::string 为元素，
+ *        对比 Tiny::vector 与 std::vector 的右值 push_back、emplace_back、头部插入与整体移动赋值
+ */
+namespace
+{
+    constexpr size_t COUNT = 1000000;
+    constexpr size_t FRONT_INSERTS = 2000;
+    constexpr int ROUNDS = 5;
+
+    std::string make(const size_t i)
+    {
+        return "request-" + std::to_string(i) + "-payload-padding-to-defeat-sso";
+    }
+
+    template <typename F>
+    double best_of(F&& f)
+    {
+        double best = 1e9;
+        for (int r = 0; r < ROUNDS; ++r)
+        {
+            const auto begin = std::chrono::steady_clock::now();
+            f();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    template <typename Vector>
+    void run(const char* name)
+    {
+        const double push = best_of([]
+        {
+            Vector v;
+            for (size_t i = 0; i < COUNT; ++i)
+                v.push_back(make(i));
+        });
+        const double emplace = best_of([]
+        {
+            Vector v;
+            for (size_t i = 0; i < COUNT; ++i)
+                v.emplace_back(64, 'x');
+        });
+        const double front = best_of([]
+        {
+            Vector v;
+            for (size_t i = 0; i < FRONT_INSERTS; ++i)
+                v.insert(v.begin(), make(i));
+        });
+        Vector source;
+        for (size_t i = 0; i < COUNT; ++i)
+            source.push_back(make(i));
+        const double moved = best_of([&source]
+        {
+            Vector v(std::move(source));
+            source = std::move(v);
+        });
+        std::printf("%-14s push_back(T&&) %7.2f ms   emplace_back %7.2f ms   insert(begin) x%zu %7.2f ms   "
+                    "move ctor/assign %8.4f ms\n", name, push * 1e3, emplace * 1e3, FRONT_INSERTS, front * 1e3,
+                    moved * 1e3);
+    }
+}
+
+int main()
+{
+    std::printf("%zu strings of ~60 bytes, best of %d\n", COUNT, ROUNDS);
+    run<Tiny::vector<std::string>>("Tiny::vector");
+    run<std::vector<std::string>>("std::vector");
+    return 0;
+}
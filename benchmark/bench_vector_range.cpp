@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "container/vector.hpp"
+
+/**
+ * @brief vector 区间插入基准：批量导入时逐个 push_back 与一次性 insert(end, first, last) / append_range 的对比，
+ *        另测在头部插入一批元素；元素分别为 int（按字节搬迁、memmove）与 std::string
+ */
+namespace
+{
+    constexpr size_t BATCH = 4096;
+    constexpr size_t BATCHES = 256;
+    constexpr int ROUNDS = 5;
+
+    template <typename F>
+    double best_of(F&& f)
+    {
+        double best = 1e9;
+        for (int r = 0; r < ROUNDS; ++r)
+        {
+            const auto begin = std::chrono::steady_clock::now();
+            f();
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    }
+
+    template <typename T, typename Make>
+    void run(const char* name, Make make)
+    {
+        std::vector<T> batch;
+        for (size_t i = 0; i < BATCH; ++i)
+            batch.push_back(make(i));
+
+        const double push = best_of([&batch]
+        {
+            Tiny::vector<T> v;
+            for (size_t b = 0; b < BATCHES; ++b)
+            {
+                for (const T& x : batch)
+                    v.push_back(x);
+            }
+        });
+        const double insert = best_of([&batch]
+        {
+            Tiny::vector<T> v;
+            for (size_t b = 0; b < BATCHES; ++b)
+                v.insert(v.end(), batch.begin(), batch.end());
+        });
+        const double append = best_of([&batch]
+        {
+            Tiny::vector<T> v;
+            for (size_t b = 0; b < BATCHES; ++b)
+                v.append_range(batch);
+        });
+        const double std_insert = best_of([&batch]
+        {
+            std::vector<T> v;
+            for (size_t b = 0; b < BATCHES; ++b)
+                v.insert(v.end(), batch.begin(), batch.end());
+        });
+        const double front = best_of([&batch]
+        {
+            Tiny::vector<T> v(batch.begin(), batch.end());
+            for (size_t b = 0; b < 16; ++b)
+                v.insert(v.begin(), batch.begin(), batch.end());
+        });
+        const double std_front = best_of([&batch]
+        {
+            std::vector<T> v(batch.begin(), batch.end());
+            for (size_t b = 0; b < 16; ++b)
+                v.insert(v.begin(), batch.begin(), batch.end());
+        });
+        std::printf("%-12s push_back loop %8.2f ms   insert(end) %8.2f ms   append_range %8.2f ms   "
+                    "std insert(end) %8.2f ms   insert(begin) x16 %7.2f ms (std %7.2f ms)\n", name, push * 1e3,
+                    insert * 1e3, append * 1e3, std_insert * 1e3, front * 1e3, std_front * 1e3);
+    }
+}
+
+int main()
+{
+    std::printf("%zu batches of %zu elements, best of %d\n", BATCHES, BATCH, ROUNDS);
+    run<int>("int", [](const size_t i) { return static_cast<int>(i); });
+    run<std::string>("std::string", [](const size_t i)
+    {
+        return "record-" + std::to_string(i) + "-payload-padding-to-defeat-sso";
+    });
+    return 0;
+}
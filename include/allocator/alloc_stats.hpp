@@ -0,0 +1,101 @@
+#ifndef TINY_STL_ALLOC_STATS_HPP
+#define TINY_STL_ALLOC_STATS_HPP
+#include <atomic>
+#include <cstddef>
+
+///< 是否编译分配器统计计数，定义为 0 时所有计数代码在编译期移除，stats() 返回全零快照
+#ifndef TINY_STL_ALLOC_STATS
+#define TINY_STL_ALLOC_STATS 1
+#endif
+
+namespace Tiny
+{
+    constexpr bool alloc_stats_enabled = TINY_STL_ALLOC_STATS != 0; ///< 统计开关
+
+    /**
+     * @brief 单写者计数器：只由所属线程修改，其他线程可随时读取
+     *
+     * 修改使用 relaxed 的读取加写入而非原子读改写指令，热路径上的开销与普通变量相同。
+     */
+    class relaxed_counter
+    {
+    public:
+        void add(const size_t n)
+        {
+            m_value.store(m_value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        void sub(const size_t n)
+        {
+            m_value.store(m_value.load(std::memory_order_relaxed) - n, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] size_t load() const
+        {
+            return m_value.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<size_t> m_value{0};
+    };
+
+    /**
+     * @brief 二级配置器的计数器组，多线程模式下每个线程缓存各持有一份
+     */
+    template <size_t N>
+    struct pool_counters
+    {
+        relaxed_counter allocations[N]; ///< 各尺寸类别的分配次数
+        relaxed_counter deallocations[N]; ///< 各尺寸类别的释放次数
+        relaxed_counter large_allocations; ///< 转交一级配置器的分配次数
+        relaxed_counter large_deallocations; ///< 转交一级配置器的释放次数
+        relaxed_counter refills; ///< 自由链表（或线程缓存）补充次数
+        relaxed_counter cached_bytes; ///< 线程缓存中的空闲字节数
+    };
+
+    /**
+     * @brief 二级配置器的统计快照
+     */
+    template <size_t N>
+    struct pool_stats
+    {
+        size_t allocations[N] = {}; ///< 各尺寸类别的分配次数
+        size_t deallocations[N] = {}; ///< 各尺寸类别的释放次数
+        size_t large_allocations = 0; ///< 超过 MAX_BYTES、转交一级配置器的分配次数
+        size_t large_deallocations = 0; ///< 超过 MAX_BYTES、转交一级配置器的释放次数
+        size_t refills = 0; ///< 自由链表（或线程缓存）补充次数
+        size_t chunk_allocs = 0; ///< chunk_alloc 向系统申请区块的次数
+        size_t chunks_released = 0; ///< trim() 归还系统的区块数
+        size_t mmap_chunks = 0; ///< 以普通页 mmap 映射的区块数（其余区块来自 malloc）
+        size_t huge_page_chunks = 0; ///< 以透明大页映射的区块数
+        size_t free_list_bytes = 0; ///< 共享自由链表（多线程模式下为中心链表）中的空闲字节数
+        size_t thread_cache_bytes = 0; ///< 各线程缓存中的空闲字节数
+        size_t pool_bytes = 0; ///< 内存池中尚未切分的字节数
+        size_t heap_size = 0; ///< 从系统申请且尚未归还的字节数
+        size_t oom_handler_calls = 0; ///< 一级配置器 OOM 处理函数被调用的次数
+    };
+
+    /**
+     * @brief 对象池的统计快照：字段与只有一个尺寸类别的二级配置器相同，另附容量相关的计数
+     */
+    struct object_pool_stats : pool_stats<1>
+    {
+        size_t live_objects = 0; ///< 已取出尚未归还的对象数
+        size_t capacity = 0; ///< 同时存活对象数的上限，0 表示不限
+        size_t blocked_creates = 0; ///< create() 因达到容量上限而等待的次数
+        size_t rejected_creates = 0; ///< try_create() 因达到容量上限而失败的次数
+    };
+
+    /**
+     * @brief 一级配置器的统计快照
+     */
+    struct malloc_stats
+    {
+        size_t allocations = 0; ///< 分配次数
+        size_t deallocations = 0; ///< 释放次数
+        size_t reallocations = 0; ///< 重新分配次数
+        size_t oom_handler_calls = 0; ///< OOM 处理函数被调用的次数
+    };
+}
+
+#endif
@@ -1,20 +1,64 @@
 #ifndef TINY_STL_ALLOCATOR_HPP
 #define TINY_STL_ALLOCATOR_HPP
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <algorithm>
 #include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 
+#include "alloc_stats.hpp"
+#include "chunk_source.hpp"
 #include "construct.hpp"
+#include "free_list.hpp"
+#include "hardening.hpp"
+#include "heap_profiler.hpp"
+#include "simd_memops.hpp"
+#include "size_class.hpp"
 #include "iterator/iterator.hpp"
 
 namespace Tiny
 {
+    /**
+     * @brief 通用的超对齐分配辅助：在至少 n + align 字节、按 sizeof(size_t) 对齐的内存 raw 中
+     *        取出按 align 对齐的地址，并把它相对 raw 的偏移量记录在紧邻其前的 size_t 中
+     *
+     * align 必须是 2 的幂且大于 raw 本身的对齐，因此偏移量在 [sizeof(size_t), align] 之间。
+     */
+    inline void* align_and_record(void* raw, const size_t align)
+    {
+        char* p = static_cast<char*>(raw);
+        auto aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(p) + align) & ~(uintptr_t(align) - 1));
+        reinterpret_cast<size_t*>(aligned)[-1] = static_cast<size_t>(aligned - p);
+        return aligned;
+    }
+
+    /**
+     * @brief 由 align_and_record 返回的地址还原原始内存的起始地址
+     */
+    inline void* aligned_origin(void* aligned)
+    {
+        return static_cast<char*>(aligned) - static_cast<size_t*>(aligned)[-1];
+    }
+
     /**
      * @brief 模板类 malloc_alloc_template，用于管理内存分配
      */
     template <int>
     class malloc_alloc_template
     {
+    public:
+        using oom_handler = void (*)(); ///< 内存不足处理函数：释放内存后返回以便重试，或抛出异常
+        using reclaim_hook = size_t (*)(); ///< 缓存回收函数：归还缓存的内存，返回归还的字节数
+
+        enum
+        {
+            MAX_RECLAIM_HOOKS = 32, ///< 可同时登记的缓存回收函数个数
+            DEFAULT_OOM_RETRIES = 8 ///< 默认最多调用 OOM 处理函数的次数
+        };
+
     private:
         /**
          * @brief 内存分配失败处理：当 malloc 失败时调用该函数
@@ -27,9 +71,34 @@ namespace Tiny
         static void* oom_realloc(void*, size_t);
 
         /**
-         * @brief 自定义内存分配失败处理函数
+         * @brief 内存分配失败处理：当对齐分配失败时调用该函数
+         */
+        static void* oom_malloc_aligned(size_t, size_t);
+
+        /**
+         * @brief 分配失败后的重试策略：先让登记的缓存归还内存，再调用至多 oom_retry_limit 次 OOM 处理函数，
+         *        每次之后以 retry 重试；仍失败时抛出 std::bad_alloc
+         */
+        template <typename Retry>
+        static void* retry_after_oom(Retry retry);
+
+        static std::atomic<oom_handler> malloc_alloc_oom_handler; ///< 自定义内存分配失败处理函数
+        static std::atomic<unsigned> oom_retry_limit; ///< 调用 OOM 处理函数的次数上限
+        static std::atomic<reclaim_hook> reclaim_hooks[MAX_RECLAIM_HOOKS]; ///< 登记的缓存回收函数，空位为 nullptr
+
+        /**
+         * @brief 统计计数加一，关闭统计时为空操作
          */
-        static std::function<void()> malloc_alloc_oom_handler;
+        static void count(std::atomic<size_t>& counter)
+        {
+            if constexpr (alloc_stats_enabled)
+                counter.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static std::atomic<size_t> allocations; ///< 分配次数
+        static std::atomic<size_t> deallocations; ///< 释放次数
+        static std::atomic<size_t> reallocations; ///< 重新分配次数
+        static std::atomic<size_t> oom_handler_calls; ///< OOM 处理函数被调用的次数
 
     public:
         /**
@@ -37,9 +106,11 @@ namespace Tiny
          */
         static void* allocate(const size_t n)
         {
+            count(allocations);
             void* result = malloc(n);
             if (nullptr == result)
                 result = oom_malloc(n);
+            heap_profiler::on_allocate(result, n);
             return result;
         }
 
@@ -48,6 +119,59 @@ namespace Tiny
          */
         static void deallocate(void* p, size_t /** n */)
         {
+            count(deallocations);
+            heap_profiler::on_deallocate(p);
+            free(p);
+        }
+
+        /**
+         * @brief 分配 count 个 n 字节的内存块写入 out，任一块失败时已分配的块全部释放并重新抛出异常
+         */
+        static void allocate_batch(const size_t n, const size_t count, void** out)
+        {
+            size_t i = 0;
+            try
+            {
+                for (; i < count; ++i)
+                    out[i] = allocate(n);
+            }
+            catch (...)
+            {
+                deallocate_batch(n, i, out);
+                throw;
+            }
+        }
+
+        /**
+         * @brief 释放 ptrs 中的 count 个 n 字节内存块
+         */
+        static void deallocate_batch(const size_t n, const size_t count, void* const* ptrs)
+        {
+            for (size_t i = 0; i < count; ++i)
+                deallocate(ptrs[i], n);
+        }
+
+        /**
+         * @brief 按 align 对齐分配内存（align 为 2 的幂），以 deallocate_aligned 释放
+         */
+        static void* allocate_aligned(const size_t n, size_t align)
+        {
+            count(allocations);
+            align = align < sizeof(void*) ? sizeof(void*) : align;
+            void* result = nullptr;
+            if (0 != posix_memalign(&result, align, n))
+                result = oom_malloc_aligned(n, align);
+            heap_profiler::on_allocate(result, n);
+            return result;
+        }
+
+        /**
+         * @brief 释放 allocate_aligned 分配的内存
+         */
+        static void deallocate_aligned(void* p, size_t /** n */, size_t /** align */)
+        {
+            count(deallocations);
+            heap_profiler::on_deallocate(p);
             free(p);
         }
 
@@ -56,67 +180,186 @@ namespace Tiny
          */
         static void* reallocate(void* p, size_t /** old_sz */, const size_t new_sz)
         {
+            count(reallocations);
+            // 旧记录先摘下，realloc 成功后才扣除；失败时 oom_realloc 抛出异常，p 仍然有效，记录放回
+            const heap_profiler::detached sample = heap_profiler::on_reallocate_begin(p);
             void* result = realloc(p, new_sz);
             if (nullptr == result)
-                result = oom_realloc(p, new_sz);
+            {
+                try
+                {
+                    result = oom_realloc(p, new_sz);
+                }
+                catch (...)
+                {
+                    heap_profiler::on_reallocate_failed(p, sample);
+                    throw;
+                }
+            }
+            heap_profiler::on_reallocate_end(sample, result, new_sz);
             return result;
         }
 
         /**
-         * @brief 设置自定义内存分配失败处理函数
+         * @brief 设置自定义内存分配失败处理函数，返回旧的处理函数；可在任意线程调用
+         */
+        static oom_handler set_malloc_handler(const oom_handler f)
+        {
+            return malloc_alloc_oom_handler.exchange(f, std::memory_order_acq_rel);
+        }
+
+        /**
+         * @brief 设置一次分配失败后最多调用 OOM 处理函数的次数，返回旧值；为 0 时只回收缓存后重试一次
+         */
+        static unsigned set_oom_retry_limit(const unsigned n)
+        {
+            return oom_retry_limit.exchange(n, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 登记缓存回收函数，分配失败时在调用 OOM 处理函数之前先调用它们；
+         *        重复登记同一函数只保留一份，登记表已满时返回 false
+         *
+         * 回收函数可能在任意线程、任意分配失败时被调用，不得阻塞等待其他线程，也不得重入调用线程正持有的锁。
+         */
+        static bool add_reclaim_hook(const reclaim_hook f)
+        {
+            for (auto& slot : reclaim_hooks)
+            {
+                if (slot.load(std::memory_order_acquire) == f)
+                    return true;
+            }
+            for (auto& slot : reclaim_hooks)
+            {
+                reclaim_hook expected = nullptr;
+                if (slot.compare_exchange_strong(expected, f, std::memory_order_acq_rel))
+                    return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief 注销缓存回收函数
+         */
+        static void remove_reclaim_hook(const reclaim_hook f)
+        {
+            for (auto& slot : reclaim_hooks)
+            {
+                reclaim_hook expected = f;
+                slot.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+            }
+        }
+
+        /**
+         * @brief 依次调用全部缓存回收函数，返回归还的总字节数
+         */
+        static size_t release_cached_memory()
+        {
+            size_t released = 0;
+            for (auto& slot : reclaim_hooks)
+            {
+                if (const reclaim_hook f = slot.load(std::memory_order_acquire))
+                    released += f();
+            }
+            return released;
+        }
+
+        /**
+         * @brief 获取统计快照
          */
-        static std::function<void()> set_malloc_handler(std::function<void()> f)
+        static malloc_stats stats()
         {
-            std::function<void()> old = malloc_alloc_oom_handler; // 保存旧的处理函数
-            malloc_alloc_oom_handler = std::move(f); // 设置新的处理函数
-            return old; // 返回旧的处理函数
+            malloc_stats result;
+            result.allocations = allocations.load(std::memory_order_relaxed);
+            result.deallocations = deallocations.load(std::memory_order_relaxed);
+            result.reallocations = reallocations.load(std::memory_order_relaxed);
+            result.oom_handler_calls = oom_handler_calls.load(std::memory_order_relaxed);
+            return result;
         }
     };
 
     ///< 初始化静态成员变量 malloc_alloc_oom_handler
     template <int Align>
-    std::function<void()> malloc_alloc_template<Align>::malloc_alloc_oom_handler = nullptr;
+    std::atomic<typename malloc_alloc_template<Align>::oom_handler> malloc_alloc_template<Align>::malloc_alloc_oom_handler{
+        nullptr
+    };
 
-    /**
-     * @brief 自定义的 malloc 失败处理函数
-     */
     template <int ints>
-    void* malloc_alloc_template<ints>::oom_malloc(const size_t n)
+    std::atomic<unsigned> malloc_alloc_template<ints>::oom_retry_limit{DEFAULT_OOM_RETRIES};
+
+    template <int ints>
+    std::atomic<typename malloc_alloc_template<ints>::reclaim_hook> malloc_alloc_template<ints>::reclaim_hooks[
+        MAX_RECLAIM_HOOKS] = {};
+
+    template <int ints>
+    std::atomic<size_t> malloc_alloc_template<ints>::allocations{0};
+
+    template <int ints>
+    std::atomic<size_t> malloc_alloc_template<ints>::deallocations{0};
+
+    template <int ints>
+    std::atomic<size_t> malloc_alloc_template<ints>::reallocations{0};
+
+    template <int ints>
+    std::atomic<size_t> malloc_alloc_template<ints>::oom_handler_calls{0};
+
+    template <int ints>
+    template <typename Retry>
+    void* malloc_alloc_template<ints>::retry_after_oom(Retry retry)
     {
-        std::function<void()> my_malloc_handler = nullptr;
-        for (;;)
+        // 先让各级缓存归还内存，归还了内存才值得立即重试
+        if (0 != release_cached_memory())
         {
-            my_malloc_handler = malloc_alloc_oom_handler;
+            if (void* result = retry())
+                return result;
+        }
+        const unsigned limit = oom_retry_limit.load(std::memory_order_relaxed);
+        for (unsigned attempt = 0; attempt < limit; ++attempt)
+        {
+            // 每次都重新读取，处理函数可以在重试之间被替换或清除
+            const oom_handler handler = malloc_alloc_oom_handler.load(std::memory_order_acquire);
             // 如果没有设置处理函数，抛出 std::bad_alloc 异常
-            if (nullptr == my_malloc_handler)
-                throw std::bad_alloc();
-            // 调用当前的内存分配失败处理函数
-            my_malloc_handler();
-            // 尝试重新分配内存
-            if (void* result = malloc(n))
-            {
+            if (nullptr == handler)
+                break;
+            count(oom_handler_calls);
+            handler();
+            if (void* result = retry())
                 return result;
-            }
+            // 处理函数释放的内存可能又被其他线程的缓存占去，下一次重试前再回收一遍
+            release_cached_memory();
         }
+        throw std::bad_alloc();
+    }
+
+    /**
+     * @brief 自定义的 malloc 失败处理函数
+     */
+    template <int ints>
+    void* malloc_alloc_template<ints>::oom_malloc(const size_t n)
+    {
+        return retry_after_oom([n] { return malloc(n); });
     }
 
     /**
-     * @brief 自定义的 realloc 失败处理函数
+     * @brief 自定义的 realloc 失败处理函数，失败时原内存保持不变
      */
     template <int ints>
     void* malloc_alloc_template<ints>::oom_realloc(void* p, const size_t n)
     {
-        std::function<void()> my_alloc_handler = nullptr;
-        for (;;)
+        return retry_after_oom([p, n] { return realloc(p, n); });
+    }
+
+    /**
+     * @brief 自定义的对齐分配失败处理函数
+     */
+    template <int ints>
+    void* malloc_alloc_template<ints>::oom_malloc_aligned(const size_t n, const size_t align)
+    {
+        return retry_after_oom([n, align]
         {
-            my_alloc_handler = malloc_alloc_oom_handler;
-            // 如果没有设置处理函数，抛出 std::bad_alloc 异常
-            if (nullptr == my_alloc_handler)
-                throw std::bad_alloc();
-            // 尝试重新分配内存
-            if (void* result = realloc(p, n))
-                return result;
-        }
+            void* result = nullptr;
+            return 0 == posix_memalign(&result, align, n) ? result : nullptr;
+        });
     }
 
     ///< 定义一个 malloc_alloc 类型，使用默认 Align 为 0
@@ -124,12 +367,12 @@ namespace Tiny
 
     enum
     {
-        ALIGN = 8 ///< 对齐边界，通常为8字节对齐
+        ALIGN = default_size_classes::ALIGN ///< 默认尺寸类别的对齐边界，通常为8字节对齐
     };
 
     enum
     {
-        MAX_BYTES = 128 ///< 内存池中每个内存块的最大字节数
+        MAX_BYTES = default_size_classes::MAX_BYTES ///< 默认尺寸类别下内存池中每个内存块的最大字节数
     };
 
     enum
@@ -139,11 +382,36 @@ namespace Tiny
 
     /**
      * @brief 默认分配器模板类、二级配置器
+     *
+     * threads 为 true 时启用多线程模式：每个线程持有各尺寸自由链表的本地缓存，
+     * 分配与释放的热路径不加锁；缓存耗尽或积压过多时才与无锁的中心自由链表批量交换内存块，
+     * 只有从内存池切分新块时才需要加锁。
+     *
+     * 每个从系统申请的区块（chunk）都带有区块头并串在区块链表中，trim() 会把其中全部空闲的区块归还系统。
+     *
+     * SizeClass 决定尺寸类别布局（见 size_class.hpp），超过 SizeClass::MAX_BYTES 的请求交给一级配置器。
+     * ChunkSource 决定区块从何处申请（见 chunk_source.hpp），例如 huge_page_chunk_source 使用 2 MiB 对齐的透明大页。
+     *
+     * 每个类别的补充批量采用慢启动：从 MIN_REFILL_OBJS 起步，每次补充后翻倍直到 max_batch；
+     * 自由链表积压超过上限时批量减半。冷门类别因此只占用少量内存，热门类别则很少需要补充。
+     *
+     * 统计计数（见 alloc_stats.hpp）由 stats() 汇总为快照；多线程模式下计数分散在各线程缓存中，热路径不产生竞争。
      */
-    template <bool threads, int ints>
+    template <bool threads, int ints, typename SizeClass = default_size_classes,
+              typename ChunkSource = malloc_chunk_source>
     class default_alloc_template
     {
+    public:
+        static constexpr size_t ALIGN = SizeClass::ALIGN; ///< 对齐边界
+        static constexpr size_t MAX_BYTES = SizeClass::MAX_BYTES; ///< 池化的最大请求字节数
+        static constexpr size_t NFREELISTS = SizeClass::NFREELISTS; ///< 自由链表数量
+        static constexpr bool THREAD_SAFE = threads; ///< 能否被多个线程同时调用（包括 trim）
+
+        typedef pool_stats<NFREELISTS> stats_type; ///< 统计快照类型
+
     private:
+        typedef pool_counters<NFREELISTS> counters_type;
+
         /**
          * @brief 对齐到最近的对齐边界
          */
@@ -157,7 +425,15 @@ namespace Tiny
          */
         static size_t FREELIST_INDEX(const size_t bytes)
         {
-            return (bytes + ALIGN - 1) / ALIGN - 1;
+            return SizeClass::index(bytes);
+        }
+
+        /**
+         * @brief 计算请求大小所属类别的块大小
+         */
+        static size_t CLASS_SIZE(const size_t bytes)
+        {
+            return SizeClass::size(SizeClass::index(bytes));
         }
 
         /**
@@ -176,282 +452,1646 @@ namespace Tiny
          */
         union obj
         {
-            obj* free_list_link; ///< 指向下一个空闲内存块
+            ///< 指向下一个空闲内存块，以宽松原子方式读写（见 lock_free_free_list），加固模式下编码保存
+            std::conditional_t<alloc_hardened_enabled, encoded_link<obj, ALIGN>, relaxed_link<obj>> free_list_link;
             char client_data[1]; ///< 存储实际分配的内存数据
         };
 
-    private:
-        static obj* volatile free_list[NFREELISTS]; ///<自由链表数组
-        static char* start_free; ///<内存池的起始地址
-        static char* end_free; ///< 内存池的结束地址
-        static size_t heap_size; ///<堆内存的大小
+        enum
+        {
+            MIN_REFILL_OBJS = 2, ///< 每次补充的最少内存块数量，冷门类别从这里起步
+            MAX_REFILL_OBJS = 128, ///< 每次补充的最多内存块数量
+            MAX_REFILL_BYTES = 16384, ///< 单次补充的字节数上限，大类别的批量据此缩小
+            MAX_CARVE_BYTES = 262144 ///< allocate_batch 单次从内存池连续切分的字节数上限
+        };
 
-    public:
         /**
-         * @brief 分配内存
+         * @brief 区块头，位于每个从系统申请的区块起始处
          */
-        static void* allocate(size_t n);
+        struct chunk_header
+        {
+            chunk_header* next; ///< 区块链表中的下一个区块
+            size_t size; ///< 区块头之后可切分的字节数
+            size_t free_bytes; ///< trim() 统计得到的空闲字节数，等于 size 时整个区块可归还
+            chunk_origin origin; ///< 区块来源，归还时据此选择 free 或 munmap
+            char* base; ///< 区块来源返回的起始地址，超对齐时区块头位于其后
+            size_t bytes; ///< 区块来源实际提供的字节数
+        };
 
-        /**
-         * @brief 释放内存
-         */
-        static void deallocate(void* p, size_t n);
+        ///< 区块头占用的字节数，保证其后的内存满足对齐要求
+        static constexpr size_t CHUNK_HEADER = (sizeof(chunk_header) + ALIGN - 1) & ~(ALIGN - 1);
+        ///< 区块来源只保证 max_align_t 对齐，ALIGN 更大时多申请的字节数，用于把区块头挪到 ALIGN 边界
+        static constexpr size_t CHUNK_PADDING =
+            ALIGN > alignof(std::max_align_t) ? ALIGN - alignof(std::max_align_t) : 0;
 
         /**
-         * @brief 重新分配内存
+         * @brief 线程本地缓存，仅在多线程模式下使用
          */
-        static void* reallocate(void* p, size_t old_sz, size_t new_sz);
-    };
-
-    template <bool threads, int ints>
-    char* default_alloc_template<threads, ints>::start_free = nullptr; ///< 初始化内存池的起始地址，初始值为 nullptr
-
-    template <bool threads, int ints>
-    char* default_alloc_template<threads, ints>::end_free = nullptr; ///< 内存池的结束地址
-
-    template <bool threads, int ints>
-    size_t default_alloc_template<threads, ints>::heap_size = 0; ///< 内存池的总大小
+        struct thread_cache
+        {
+            obj* free_list[NFREELISTS] = {}; ///< 线程私有的自由链表数组
+            size_t length[NFREELISTS] = {}; ///< 各链表当前长度
+            size_t batch[NFREELISTS] = {}; ///< 各类别下一次补充的块数
+            counters_type counters; ///< 本线程的统计计数
+            thread_cache* prev = nullptr; ///< 统计登记表中的前一个缓存
+            thread_cache* next = nullptr; ///< 统计登记表中的后一个缓存
 
-    template <bool threads, int ints>
-    typename default_alloc_template<threads, ints>::obj* volatile default_alloc_template<threads, ints>::free_list[
-        NFREELISTS] = {
-        nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
-        nullptr, nullptr, nullptr, nullptr
-    }; ///<自由链表数组
+            /**
+             * @brief 线程首次使用分配器时将缓存登记到统计登记表
+             */
+            thread_cache();
 
+            /**
+             * @brief 线程退出时将缓存中的内存块全部归还中心池，并把计数并入全局计数
+             */
+            ~thread_cache();
+        };
 
-    template <bool threads, int ints>
-    char* default_alloc_template<threads, ints>::chunk_alloc(const size_t size, int& nobjs)
-    {
-        char* result; // 结果指针，指向分配的内存块
-        size_t total_bytes = size * nobjs; // 计算需要的总字节数
+        /**
+         * @brief 类别 index 单次补充块数的上限
+         */
+        static size_t max_batch(const size_t index)
+        {
+            const size_t objs = MAX_REFILL_BYTES / SizeClass::size(index);
+            return std::clamp<size_t>(objs, MIN_REFILL_OBJS, MAX_REFILL_OBJS);
+        }
 
-        // 步骤 1: 检查内存池中是否有足够的空间
-        if (const auto bytes_left = static_cast<size_t>(end_free - start_free); bytes_left >= total_bytes)
+        /**
+         * @brief 慢启动：返回本次补充的块数，并把下一次的块数翻倍（不超过 max_batch）
+         */
+        static int grow_batch(size_t& batch, const size_t index)
         {
-            result = start_free; // 直接从内存池中分配内存
-            start_free += total_bytes; // 更新内存池起始地址
-            return result;
+            const size_t n = std::max<size_t>(batch, MIN_REFILL_OBJS);
+            batch = std::min(2 * n, max_batch(index));
+            return static_cast<int>(n);
         }
-        // 步骤 2: 内存池中剩余空间足够一个块，但不够全部分配
-        else if (bytes_left >= size)
+
+        /**
+         * @brief 自由链表积压时将下一次补充的块数减半（不低于 MIN_REFILL_OBJS）
+         */
+        static void shrink_batch(size_t& batch)
         {
-            nobjs = bytes_left / size; // 根据剩余空间确定可以分配多少个块
-            total_bytes = nobjs * size; // 重新计算实际分配的总字节数
-            result = start_free; // 从内存池中分配内存
-            start_free += total_bytes; // 更新内存池起始地址
-            return result;
+            batch = std::max<size_t>(batch / 2, MIN_REFILL_OBJS);
         }
-        // 步骤 3: 内存池没有足够空间，需要从系统申请新的内存块
-        else
+
+        /**
+         * @brief 自由链表长度上限：超过后视为积压，收缩批量（多线程模式下还要归还一批给中心池）
+         */
+        static size_t list_limit(const size_t batch, const size_t index)
         {
-            /**
-             * heap_size 是已经从系统中分配的堆的大小，通过右移 4 位 (>> 4) 来计算出一个比例值，
-             * 相当于 heap_size / 16。这是为了根据目前已分配的内存大小，动态地调整新分配的内存数量。
-             * 这样可以让每次新申请的内存不仅与当前的需求相关，也与已经分配的内存量相关。
-             */
-            const size_t bytes_to_get = 2 * total_bytes + ROUND_UP(heap_size >> 4); // 计算需要申请的内存大小
+            return batch + max_batch(index);
+        }
 
-            // 步骤 4: 将剩余的内存块返回到相应的自由链表中（如果有剩余空间）
-            if (bytes_left > 0)
-            {
-                // 根据剩余空间的大小选择相应的自由链表
-                obj* volatile * my_free_list = free_list + FREELIST_INDEX(bytes_left);
-                // 将剩余的内存块插入到自由链表中
-                reinterpret_cast<obj*>(start_free)->free_list_link = *my_free_list;
-                *my_free_list = reinterpret_cast<obj*>(start_free);
-            }
+        /**
+         * @brief 将 chunk 中第 2 到第 nobjs 块串成自由链表，返回链表头
+         */
+        static obj* link_chunk(char* chunk, size_t n, int nobjs);
+
+        /**
+         * @brief 多线程模式下补充当前线程的缓存
+         */
+        static void* refill_cache(size_t n);
+
+        /**
+         * @brief 多线程模式下将线程缓存中前 count 个内存块归还中心池
+         */
+        static void release_to_central(thread_cache& tc, size_t index, size_t count);
+
+        /**
+         * @brief 将已串好的链 [first, last] 压入共享自由链表（多线程模式下为中心无锁链表）
+         */
+        static void push_free(size_t index, obj* first, obj* last);
+
+        /**
+         * @brief 从共享自由链表弹出单个内存块，链表为空时返回 nullptr
+         */
+        static obj* pop_free(size_t index);
+
+        /**
+         * @brief 摘下共享自由链表中的全部内存块
+         */
+        static obj* detach_free(size_t index);
+
+        /**
+         * @brief 多线程模式下等待所有在 trim() 摘链之前开始的无锁弹出操作结束
+         */
+        static void synchronize_readers();
 
-            // 步骤 5: 从系统中申请新的内存块
-            start_free = static_cast<char*>(malloc(bytes_to_get)); // 使用 malloc 从系统分配内存
-            if (nullptr == start_free) // 如果分配失败，尝试从自由链表中获取内存块
+        /**
+         * @brief trim() 的实现，wait 为 false 时内存池正被其他线程持有则直接返回 0
+         */
+        static size_t trim(bool wait);
+
+        /**
+         * @brief 登记到一级配置器的缓存回收函数，在内存不足时归还完全空闲的区块
+         *
+         * 调用线程正在向系统申请区块（已持有本池）时跳过；单线程模式的池只由最近一次扩充它的线程回收。
+         */
+        static size_t reclaim();
+
+        /**
+         * @brief 调整共享自由链表的空闲字节计数，关闭统计时为空操作
+         */
+        static void count_shared_bytes(const size_t add, const size_t sub)
+        {
+            if constexpr (alloc_stats_enabled)
             {
-                // 遍历不同大小的自由链表，尝试获取合适的内存块
-                for (auto i = size; i <= MAX_BYTES; i += ALIGN)
-                {
-                    obj* volatile * my_free_list = free_list + FREELIST_INDEX(i); // 获取对应大小的自由链表
-                    obj* p = *my_free_list; // 获取自由链表中的第一个内存块
-                    if (nullptr != p)
-                    {
-                        // 如果自由链表中有可用的内存块，从链表中取出并更新起始和结束地址
-                        *my_free_list = p->free_list_link;
-                        start_free = reinterpret_cast<char*>(p);
-                        end_free = start_free + i;
-                        return chunk_alloc(size, nobjs); // 递归调用分配函数
-                    }
-                }
-                end_free = nullptr; // 如果没有可用内存块，标记内存池为空
+                if constexpr (threads)
+                    shared_free_bytes.fetch_add(add - sub, std::memory_order_relaxed);
+                else
+                    shared_free_bytes.store(shared_free_bytes.load(std::memory_order_relaxed) + add - sub,
+                                            std::memory_order_relaxed);
             }
+        }
 
-            // 步骤 6: 更新内存池大小
-            heap_size += bytes_to_get; // 更新总堆大小
-            end_free = start_free + bytes_to_get; // 更新内存池结束地址
-            return chunk_alloc(size, nobjs); // 递归调用分配函数
+        /**
+         * @brief 当前线程使用的计数器组：多线程模式下为线程缓存中的计数，否则为全局计数
+         */
+        static counters_type& local_counters()
+        {
+            if constexpr (threads)
+                return cache.counters;
+            else
+                return global_counters;
         }
-    }
 
+        /**
+         * @brief 将一组计数累加到统计快照
+         */
+        static void collect(stats_type& result, const counters_type& counters);
 
-    /**
-     * @brief 向自由链表补充新的内存块
-     */
-    template <bool threads, int ints>
-    void* default_alloc_template<threads, ints>::refill(const size_t n)
-    {
-        int nobjs = 20; // 默认尝试分配20个块
-        char* chunk = chunk_alloc(n, nobjs); // 从内存池分配nobjs个n字节的内存块
-        obj* next_obj;
+        /**
+         * @brief 按地址升序对单链表做原地归并排序，不申请额外内存
+         */
+        template <typename Node, typename Link>
+        static Node* sort_by_address(Node* head, Link Node::* link);
 
-        // 如果只分配到了1个内存块，直接返回（此时无法补充到自由链表，只能满足本次请求）
-        if (1 == nobjs)
+        typedef block_guard<ALIGN> guard; ///< 加固模式下的块布局
+
+        /**
+         * @brief 加固模式下请求是否由池分配：加上保护字节后仍能放进池中的请求（含大小为 0 的请求），
+         *        其余请求交给一级配置器，池中不存在不带保护字节的块
+         */
+        static bool guarded(const size_t n)
+        {
+            return n <= MAX_BYTES - guard::OVERHEAD;
+        }
+
+        /**
+         * @brief 池中分配的内存块交给采样堆分析器；更大的请求已由一级配置器采样
+         */
+        static void* profile(void* p, const size_t n)
+        {
+            if (n <= MAX_BYTES)
+                heap_profiler::on_allocate(p, n);
+            return p;
+        }
+
+        /**
+         * @brief 从池中分配内存块，不做加固处理
+         */
+        static void* allocate_block(size_t n);
+
+        /**
+         * @brief 将内存块放回池中，不做加固处理
+         */
+        static void deallocate_block(void* p, size_t n);
+
+    private:
+        static obj* volatile free_list[NFREELISTS]; ///<自由链表数组
+        static size_t free_length[NFREELISTS]; ///< 单线程模式下各自由链表的长度
+        static size_t refill_batch[NFREELISTS]; ///< 单线程模式下各类别下一次补充的块数
+        static char* start_free; ///<内存池的起始地址
+        static char* end_free; ///< 内存池的结束地址
+        static size_t heap_size; ///<堆内存的大小
+        static lock_free_free_list<obj> central_list[NFREELISTS]; ///< 多线程模式下的中心无锁自由链表
+        static chunk_header* chunk_list; ///< 从系统申请的全部区块
+        static std::mutex central_mutex; ///< 多线程模式下保护内存池（start_free、end_free、heap_size、chunk_list）
+        static std::atomic<unsigned> reader_epoch; ///< 多线程模式下无锁弹出操作的当前纪元
+        static std::atomic<size_t> readers[2]; ///< 按纪元奇偶统计正在进行的无锁弹出操作数
+        static thread_local thread_cache cache; ///< 当前线程的本地缓存
+        static counters_type global_counters; ///< 单线程模式下的计数；多线程模式下累积已退出线程的计数
+        static std::atomic<size_t> shared_free_bytes; ///< 共享自由链表中的空闲字节数
+        static size_t chunk_allocs; ///< 向系统申请区块的次数，与内存池一同受 central_mutex 保护
+        static size_t chunks_released; ///< trim() 归还的区块数，与内存池一同受 central_mutex 保护
+        static size_t chunk_origins[3]; ///< 按来源统计申请的区块数，与内存池一同受 central_mutex 保护
+        static thread_cache* cache_registry; ///< 多线程模式下所有存活线程缓存组成的统计登记表
+        static std::mutex registry_mutex; ///< 保护统计登记表与全局计数的合并
+        static thread_local bool growing; ///< 当前线程正在向系统申请区块，期间内存不足不能重入本池回收
+        static std::atomic<std::thread::id> owner; ///< 单线程模式下最近一次扩充内存池的线程
+
+    public:
+        /**
+         * @brief 分配内存
+         */
+        static void* allocate(const size_t n)
+        {
+            if constexpr (alloc_hardened_enabled)
+            {
+                if (guarded(n))
+                    return profile(guard::on_allocate(allocate_block(n + guard::OVERHEAD), n), n);
+                if constexpr (alloc_stats_enabled)
+                    local_counters().large_allocations.add(1);
+                return malloc_alloc::allocate(n); // 一级配置器自行采样
+            }
+            return profile(allocate_block(n), n);
+        }
+
+        /**
+         * @brief 释放内存，n 须与分配时相同
+         *
+         * 加固模式下会检查重复释放、大小不符与越界写入，发现后打印诊断信息并终止进程。
+         */
+        static void deallocate(void* p, const size_t n)
+        {
+            if constexpr (alloc_hardened_enabled)
+            {
+                if (!guarded(n))
+                {
+                    if constexpr (alloc_stats_enabled)
+                        local_counters().large_deallocations.add(1);
+                    return malloc_alloc::deallocate(p, n);
+                }
+                heap_profiler::on_deallocate(p);
+                return deallocate_block(guard::on_deallocate(p, n), n + guard::OVERHEAD);
+            }
+            if (n <= MAX_BYTES)
+                heap_profiler::on_deallocate(p);
+            deallocate_block(p, n);
+        }
+
+        /**
+         * @brief 请求 n 字节时实际取得的块大小：池化的请求为所属类别的块大小，其余原样返回
+         *
+         * 容器可以据此把同一块内存中多出的部分计入容量；加固模式下块尾有保护字节，原样返回。
+         */
+        static size_t good_size(const size_t n)
+        {
+            if (alloc_hardened_enabled || 0 == n || n > MAX_BYTES)
+                return n;
+            return CLASS_SIZE(n);
+        }
+
+        /**
+         * @brief 一次分配 count 个 n 字节的内存块，写入 out[0, count)
+         *
+         * 池化的请求只计算一次所属类别：先整段摘取自由链表（多线程模式下依次为线程缓存与中心链表），
+         * 不足的部分直接从内存池连续切分。失败时已取得的块全部归还并重新抛出异常。
+         */
+        static void allocate_batch(size_t n, size_t count, void** out);
+
+        /**
+         * @brief 一次释放 ptrs[0, count) 中的 count 个 n 字节内存块，串成一条链后整段挂回自由链表
+         */
+        static void deallocate_batch(size_t n, size_t count, void* const* ptrs);
+
+        /**
+         * @brief 重新分配内存
+         */
+        static void* reallocate(void* p, size_t old_sz, size_t new_sz);
+
+        /**
+         * @brief 按 align 对齐分配内存（align 为 2 的幂），以 deallocate_aligned 释放
+         *
+         * align 不超过 ALIGN 时等同于 allocate；否则小请求从池中多取 align 字节并在其中对齐，
+         * 放不进池的请求交给一级配置器的对齐分配。
+         */
+        static void* allocate_aligned(size_t n, size_t align);
+
+        /**
+         * @brief 释放 allocate_aligned 分配的内存，n 与 align 须与分配时相同
+         */
+        static void deallocate_aligned(void* p, size_t n, size_t align);
+
+        /**
+         * @brief 将完全空闲的区块归还系统
+         * @return 归还的字节数（含区块头）
+         *
+         * 多线程模式下会先清空调用线程的缓存；其他线程缓存中的内存块视为在用，所在区块不会被归还。
+         */
+        static size_t trim();
+
+        /**
+         * @brief 汇总各计数器，返回统计快照
+         */
+        static stats_type stats();
+
+        /**
+         * @brief 当前从系统申请且尚未归还的字节数
+         */
+        static size_t held_bytes()
+        {
+            std::unique_lock<std::mutex> lock(central_mutex, std::defer_lock);
+            if constexpr (threads)
+                lock.lock();
+            return heap_size;
+        }
+    };
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    char* default_alloc_template<threads, ints, SizeClass, ChunkSource>::start_free = nullptr; ///< 初始化内存池的起始地址，初始值为 nullptr
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    char* default_alloc_template<threads, ints, SizeClass, ChunkSource>::end_free = nullptr; ///< 内存池的结束地址
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    size_t default_alloc_template<threads, ints, SizeClass, ChunkSource>::heap_size = 0; ///< 内存池的总大小
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    typename default_alloc_template<threads, ints, SizeClass, ChunkSource>::obj* volatile default_alloc_template<threads, ints, SizeClass, ChunkSource>::free_list[
+        NFREELISTS] = {}; ///<自由链表数组
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    size_t default_alloc_template<threads, ints, SizeClass, ChunkSource>::free_length[NFREELISTS] = {}; ///< 自由链表长度
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    size_t default_alloc_template<threads, ints, SizeClass, ChunkSource>::refill_batch[NFREELISTS] = {}; ///< 补充块数
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    typename default_alloc_template<threads, ints, SizeClass, ChunkSource>::chunk_header*
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::chunk_list = nullptr; ///< 区块链表
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    std::atomic<unsigned> default_alloc_template<threads, ints, SizeClass, ChunkSource>::reader_epoch{0}; ///< 无锁弹出纪元
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    std::atomic<size_t> default_alloc_template<threads, ints, SizeClass, ChunkSource>::readers[2] = {}; ///< 各纪元的弹出计数
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    lock_free_free_list<typename default_alloc_template<threads, ints, SizeClass, ChunkSource>::obj>
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::central_list[NFREELISTS]; ///< 中心无锁自由链表
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    std::mutex default_alloc_template<threads, ints, SizeClass, ChunkSource>::central_mutex; ///< 内存池互斥锁
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    thread_local typename default_alloc_template<threads, ints, SizeClass, ChunkSource>::thread_cache
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::cache; ///< 线程本地缓存
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    typename default_alloc_template<threads, ints, SizeClass, ChunkSource>::counters_type
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::global_counters; ///< 全局计数
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    std::atomic<size_t> default_alloc_template<threads, ints, SizeClass, ChunkSource>::shared_free_bytes{0}; ///< 共享空闲字节数
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    size_t default_alloc_template<threads, ints, SizeClass, ChunkSource>::chunk_allocs = 0; ///< 区块申请次数
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    size_t default_alloc_template<threads, ints, SizeClass, ChunkSource>::chunks_released = 0; ///< 区块归还数
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    size_t default_alloc_template<threads, ints, SizeClass, ChunkSource>::chunk_origins[3] = {}; ///< 各来源区块数
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    typename default_alloc_template<threads, ints, SizeClass, ChunkSource>::thread_cache*
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::cache_registry = nullptr; ///< 线程缓存登记表
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    std::mutex default_alloc_template<threads, ints, SizeClass, ChunkSource>::registry_mutex; ///< 登记表互斥锁
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    thread_local bool default_alloc_template<threads, ints, SizeClass, ChunkSource>::growing = false; ///< 正在申请区块
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    std::atomic<std::thread::id> default_alloc_template<threads, ints, SizeClass, ChunkSource>::owner{}; ///< 单线程池的属主
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    char* default_alloc_template<threads, ints, SizeClass, ChunkSource>::chunk_alloc(const size_t size, int& nobjs)
+    {
+        char* result; // 结果指针，指向分配的内存块
+        size_t total_bytes = size * nobjs; // 计算需要的总字节数
+
+        // 步骤 1: 检查内存池中是否有足够的空间
+        if (const auto bytes_left = static_cast<size_t>(end_free - start_free); bytes_left >= total_bytes)
+        {
+            result = start_free; // 直接从内存池中分配内存
+            start_free += total_bytes; // 更新内存池起始地址
+            return result;
+        }
+        // 步骤 2: 内存池中剩余空间足够一个块，但不够全部分配
+        else if (bytes_left >= size)
+        {
+            nobjs = bytes_left / size; // 根据剩余空间确定可以分配多少个块
+            total_bytes = nobjs * size; // 重新计算实际分配的总字节数
+            result = start_free; // 从内存池中分配内存
+            start_free += total_bytes; // 更新内存池起始地址
+            return result;
+        }
+        // 步骤 3: 内存池没有足够空间，需要从系统申请新的内存块
+        else
+        {
+            /**
+             * heap_size 是已经从系统中分配的堆的大小，通过右移 4 位 (>> 4) 来计算出一个比例值，
+             * 相当于 heap_size / 16。这是为了根据目前已分配的内存大小，动态地调整新分配的内存数量。
+             * 这样可以让每次新申请的内存不仅与当前的需求相关，也与已经分配的内存量相关。
+             */
+            const size_t bytes_to_get = 2 * total_bytes + ROUND_UP(heap_size >> 4); // 计算需要申请的内存大小
+
+            // 步骤 4: 将剩余的内存返回到相应的自由链表中（如果有剩余空间）
+            // 每次切下不超过剩余空间的最大类别块，默认尺寸类别下恰好一次切完
+            for (size_t rest = bytes_left; rest > 0;)
+            {
+                size_t index = FREELIST_INDEX(rest);
+                if (SizeClass::size(index) > rest)
+                    --index;
+                obj* block = reinterpret_cast<obj*>(start_free);
+                push_free(index, block, block);
+                count_shared_bytes(SizeClass::size(index), 0);
+                start_free += SizeClass::size(index);
+                rest -= SizeClass::size(index);
+            }
+            start_free = end_free = nullptr;
+
+            // 步骤 5: 从区块来源申请新的区块（来源可能把大小向上取整），区块头之后的部分作为内存池
+            size_t chunk_bytes = CHUNK_PADDING + CHUNK_HEADER + bytes_to_get;
+            chunk_origin origin = chunk_origin::malloc;
+            auto base = static_cast<char*>(ChunkSource::allocate(chunk_bytes, origin));
+            if (nullptr == base) // 如果分配失败，尝试从自由链表中获取内存块
+            {
+                // 遍历不同大小的自由链表，尝试获取合适的内存块
+                for (size_t i = FREELIST_INDEX(size); i < NFREELISTS; ++i)
+                {
+                    // 如果对应大小的自由链表中有可用的内存块，从链表中取出并更新起始和结束地址
+                    if (obj* p = pop_free(i); nullptr != p)
+                    {
+                        count_shared_bytes(0, SizeClass::size(i));
+                        start_free = reinterpret_cast<char*>(p);
+                        end_free = start_free + SizeClass::size(i);
+                        return chunk_alloc(size, nobjs); // 递归调用分配函数
+                    }
+                }
+                // 自由链表中也没有可用块，交给一级配置器（先回收其他池的缓存，再调用 OOM 处理函数或抛出 std::bad_alloc）
+                growing = true;
+                try
+                {
+                    base = static_cast<char*>(malloc_alloc::allocate(chunk_bytes));
+                }
+                catch (...)
+                {
+                    growing = false;
+                    throw;
+                }
+                growing = false;
+                origin = chunk_origin::malloc;
+            }
+
+            // 步骤 6: 登记区块并更新内存池大小；首次扩充时把本池登记为一级配置器的缓存回收函数
+            static const bool reclaimable = malloc_alloc::add_reclaim_hook(&reclaim);
+            (void)reclaimable;
+            if constexpr (!threads)
+                owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+            // 区块头放在 base 之后第一个 ALIGN 边界上，CHUNK_HEADER 是 ALIGN 的倍数，内存池起点随之对齐
+            const size_t lead = (ALIGN - reinterpret_cast<uintptr_t>(base) % ALIGN) % ALIGN;
+            auto chunk = reinterpret_cast<chunk_header*>(base + lead);
+            chunk->next = chunk_list;
+            chunk->size = (chunk_bytes - lead - CHUNK_HEADER) & ~(ALIGN - 1);
+            chunk->origin = origin;
+            chunk->base = base;
+            chunk->bytes = chunk_bytes;
+            chunk_list = chunk;
+            if constexpr (alloc_stats_enabled)
+            {
+                ++chunk_allocs;
+                ++chunk_origins[static_cast<size_t>(origin)];
+            }
+            start_free = reinterpret_cast<char*>(chunk) + CHUNK_HEADER;
+            heap_size += chunk->size; // 更新总堆大小
+            end_free = start_free + chunk->size; // 更新内存池结束地址
+            return chunk_alloc(size, nobjs); // 递归调用分配函数
+        }
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void default_alloc_template<threads, ints, SizeClass, ChunkSource>::push_free(const size_t index, obj* first, obj* last)
+    {
+        if constexpr (threads)
+        {
+            central_list[index].push(first, last);
+        }
+        else
+        {
+            last->free_list_link = free_list[index];
+            free_list[index] = first;
+            for (obj* p = first; p != last; p = p->free_list_link)
+                ++free_length[index];
+            ++free_length[index];
+        }
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    typename default_alloc_template<threads, ints, SizeClass, ChunkSource>::obj*
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::pop_free(const size_t index)
+    {
+        if constexpr (threads)
+        {
+            return central_list[index].pop();
+        }
+        else
+        {
+            obj* p = free_list[index];
+            if (nullptr != p)
+            {
+                free_list[index] = p->free_list_link;
+                --free_length[index];
+            }
+            return p;
+        }
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    typename default_alloc_template<threads, ints, SizeClass, ChunkSource>::obj*
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::detach_free(const size_t index)
+    {
+        if constexpr (threads)
+        {
+            return central_list[index].pop_all();
+        }
+        else
+        {
+            obj* head = free_list[index];
+            free_list[index] = nullptr;
+            free_length[index] = 0;
+            return head;
+        }
+    }
+
+
+    /**
+     * @brief 两次翻转纪元并等待旧纪元计数归零：第一次排空翻转前奇偶位上的弹出者，
+     *        第二次排空另一奇偶位上可能仍在进行的更早弹出者
+     */
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void default_alloc_template<threads, ints, SizeClass, ChunkSource>::synchronize_readers()
+    {
+        for (int phase = 0; phase < 2; ++phase)
+        {
+            const unsigned old = reader_epoch.fetch_add(1) & 1;
+            while (0 != readers[old].load())
+                std::this_thread::yield();
+        }
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    template <typename Node, typename Link>
+    Node* default_alloc_template<threads, ints, SizeClass, ChunkSource>::sort_by_address(Node* head, Link Node::* link)
+    {
+        if (nullptr == head || nullptr == static_cast<Node*>(head->*link))
+            return head;
+
+        // 快慢指针找到中点，将链表一分为二
+        Node* slow = head;
+        Node* fast = head->*link;
+        while (nullptr != fast && nullptr != static_cast<Node*>(fast->*link))
+        {
+            slow = slow->*link;
+            fast = static_cast<Node*>(fast->*link)->*link;
+        }
+        Node* right = slow->*link;
+        slow->*link = nullptr;
+        Node* left = sort_by_address(head, link);
+        right = sort_by_address(right, link);
+
+        // 合并两个有序链表
+        Node dummy;
+        Node* tail = &dummy;
+        while (nullptr != left && nullptr != right)
+        {
+            Node*& smaller = std::less<Node*>()(left, right) ? left : right;
+            tail->*link = smaller;
+            tail = smaller;
+            smaller = smaller->*link;
+        }
+        tail->*link = nullptr != left ? left : right;
+        return dummy.*link;
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    size_t default_alloc_template<threads, ints, SizeClass, ChunkSource>::trim()
+    {
+        return trim(true);
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    size_t default_alloc_template<threads, ints, SizeClass, ChunkSource>::reclaim()
+    {
+        if (growing)
+            return 0;
+        if constexpr (!threads)
+        {
+            if (owner.load(std::memory_order_relaxed) != std::this_thread::get_id())
+                return 0;
+        }
+        return trim(false);
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    size_t default_alloc_template<threads, ints, SizeClass, ChunkSource>::trim(const bool wait)
+    {
+        if constexpr (threads)
+        {
+            // 先把当前线程缓存全部归还中心池，使其中的块也能参与统计
+            thread_cache& tc = cache;
+            for (size_t i = 0; i < NFREELISTS; ++i)
+            {
+                if (0 != tc.length[i])
+                    release_to_central(tc, i, tc.length[i]);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(central_mutex, std::defer_lock);
+        if constexpr (threads)
+        {
+            if (wait)
+                lock.lock();
+            else if (!lock.try_lock())
+                return 0;
+        }
+        if (nullptr == chunk_list)
+            return 0;
+
+        // 步骤 1: 摘下全部自由链表；多线程模式下还要等已读到旧链表头的弹出操作结束
+        obj* lists[NFREELISTS];
+        for (size_t i = 0; i < NFREELISTS; ++i)
+            lists[i] = sort_by_address(detach_free(i), &obj::free_list_link);
+        if constexpr (threads)
+            synchronize_readers();
+
+        // 步骤 2: 区块与各条自由链表均按地址排序后并行扫描，累计每个区块的空闲字节数
+        chunk_list = sort_by_address(chunk_list, &chunk_header::next);
+        for (chunk_header* c = chunk_list; nullptr != c; c = c->next)
+        {
+            c->free_bytes = 0;
+            const char* begin = reinterpret_cast<char*>(c) + CHUNK_HEADER;
+            if (begin <= start_free && start_free < begin + c->size)
+                c->free_bytes += end_free - start_free; // 内存池中尚未切分的部分
+        }
+        for (size_t i = 0; i < NFREELISTS; ++i)
+        {
+            chunk_header* c = chunk_list;
+            for (obj* p = lists[i]; nullptr != p && nullptr != c; p = p->free_list_link)
+            {
+                while (nullptr != c && reinterpret_cast<char*>(c) + CHUNK_HEADER + c->size <= reinterpret_cast<char*>(p))
+                    c = c->next;
+                if (nullptr != c && reinterpret_cast<char*>(c) < reinterpret_cast<char*>(p))
+                    c->free_bytes += SizeClass::size(i);
+            }
+        }
+
+        // 步骤 3: 过滤掉位于可归还区块中的内存块，其余挂回自由链表
+        auto releasable = [](const chunk_header* c) { return c->free_bytes == c->size; };
+        size_t removed = 0; // 从自由链表中剔除的字节数
+        for (size_t i = 0; i < NFREELISTS; ++i)
+        {
+            chunk_header* c = chunk_list;
+            obj* head = nullptr;
+            obj* tail = nullptr;
+            for (obj* p = lists[i]; nullptr != p;)
+            {
+                obj* next = p->free_list_link;
+                while (nullptr != c && reinterpret_cast<char*>(c) + CHUNK_HEADER + c->size <= reinterpret_cast<char*>(p))
+                    c = c->next;
+                if (nullptr == c || reinterpret_cast<char*>(c) > reinterpret_cast<char*>(p) || !releasable(c))
+                {
+                    p->free_list_link = nullptr;
+                    if (nullptr == head)
+                        head = p;
+                    else
+                        tail->free_list_link = p;
+                    tail = p;
+                }
+                else
+                {
+                    removed += SizeClass::size(i);
+                }
+                p = next;
+            }
+            if (nullptr != head)
+                push_free(i, head, tail);
+        }
+        count_shared_bytes(0, removed);
+
+        // 步骤 4: 将可归还的区块从区块链表中摘除并交还系统
+        size_t released = 0;
+        for (chunk_header** cur = &chunk_list; nullptr != *cur;)
+        {
+            chunk_header* c = *cur;
+            if (!releasable(c))
+            {
+                cur = &c->next;
+                continue;
+            }
+            const char* begin = reinterpret_cast<char*>(c) + CHUNK_HEADER;
+            if (begin <= start_free && start_free < begin + c->size)
+                start_free = end_free = nullptr;
+            *cur = c->next;
+            heap_size -= c->size;
+            char* const base = c->base;
+            const size_t bytes = c->bytes;
+            const chunk_origin origin = c->origin;
+            released += bytes;
+            if constexpr (alloc_stats_enabled)
+                ++chunks_released;
+            // 加固模式下抹去残留的块头，malloc 重新分出这段内存时不会被误认为释放后写入
+            if (alloc_hardened_enabled && chunk_origin::malloc == origin)
+                std::memset(base, 0, bytes);
+            if (chunk_origin::malloc == origin)
+                heap_profiler::on_deallocate(base); // 区块可能来自一级配置器并被采样
+            if constexpr (has_chunk_release<ChunkSource>::value)
+                ChunkSource::release(base, bytes, origin);
+            else
+                release_chunk(base, bytes, origin);
+        }
+        return released;
+    }
+
+
+    /**
+     * @brief 将 chunk 中除第一块之外的内存块串联成自由链表
+     */
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    typename default_alloc_template<threads, ints, SizeClass, ChunkSource>::obj*
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::link_chunk(char* chunk, const size_t n, const int nobjs)
+    {
+        obj* head = reinterpret_cast<obj*>(chunk + n); // 第二块作为链表头节点
+        obj* next_obj = head;
+
+        // 遍历剩余的块，将它们串联进自由链表
+        for (int i = 1;; ++i)
+        {
+            obj* current_obj = next_obj;
+            next_obj = reinterpret_cast<obj*>(reinterpret_cast<char*>(next_obj) + n); // 指向下一个块
+            if (nobjs - 1 == i) // 最后一块
+            {
+                current_obj->free_list_link = nullptr; // 尾节点next为null
+                break;
+            }
+            current_obj->free_list_link = next_obj; // 挂接链表
+        }
+        return head;
+    }
+
+
+    /**
+     * @brief 向自由链表补充新的内存块，块数按该类别的慢启动批量决定
+     */
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void* default_alloc_template<threads, ints, SizeClass, ChunkSource>::refill(const size_t n)
+    {
+        const size_t index = FREELIST_INDEX(n);
+        int nobjs = grow_batch(refill_batch[index], index); // 冷门类别少量补充，频繁补充的类别批量逐次翻倍
+        if constexpr (alloc_stats_enabled)
+            global_counters.refills.add(1);
+        char* chunk = chunk_alloc(n, nobjs); // 从内存池分配nobjs个n字节的内存块
+
+        // 如果只分配到了1个内存块，直接返回（此时无法补充到自由链表，只能满足本次请求）
+        if (1 == nobjs)
             return chunk;
 
-        // 找到对应大小的自由链表
+        // 第一块用于返回给用户，剩下的全部挂到自由链表上
+        free_list[index] = link_chunk(chunk, n, nobjs);
+        free_length[index] = nobjs - 1;
+        count_shared_bytes((nobjs - 1) * n, 0);
+        return chunk; // 返回第一块，供本次分配使用
+    }
+
+
+    /**
+     * @brief 补充当前线程的缓存：优先从中心自由链表批量摘取，不足时再从内存池切分
+     */
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void* default_alloc_template<threads, ints, SizeClass, ChunkSource>::refill_cache(const size_t n)
+    {
+        const size_t index = FREELIST_INDEX(n);
+        thread_cache& tc = cache;
+        if constexpr (alloc_stats_enabled)
+            tc.counters.refills.add(1);
+
+        // 中心链表非空：无锁摘下至多一个批量的块，第一块返回，其余交给线程缓存
+        // 弹出期间登记在当前纪元上，使 trim() 能等到本次弹出结束后再归还区块
+        int nobjs = grow_batch(tc.batch[index], index);
+        size_t count = 0;
+        const unsigned epoch = reader_epoch.load() & 1;
+        readers[epoch].fetch_add(1);
+        obj* head = central_list[index].pop(nobjs, count);
+        readers[epoch].fetch_sub(1);
+        if (nullptr != head)
+        {
+            tc.free_list[index] = head->free_list_link;
+            tc.length[index] = count - 1;
+            count_shared_bytes(0, count * n);
+            if constexpr (alloc_stats_enabled)
+                tc.counters.cached_bytes.add((count - 1) * n);
+            return head;
+        }
+
+        // 中心链表为空：加锁从内存池切分一批新块，直接挂到线程缓存
+        std::lock_guard<std::mutex> lock(central_mutex);
+        char* chunk = chunk_alloc(n, nobjs);
+        if (nobjs > 1)
+        {
+            tc.free_list[index] = link_chunk(chunk, n, nobjs);
+            tc.length[index] = nobjs - 1;
+            if constexpr (alloc_stats_enabled)
+                tc.counters.cached_bytes.add((nobjs - 1) * n);
+        }
+        return chunk;
+    }
+
+
+    /**
+     * @brief 从线程缓存链表头部摘下 count 个块，整段无锁挂回中心自由链表
+     */
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void default_alloc_template<threads, ints, SizeClass, ChunkSource>::release_to_central(thread_cache& tc, const size_t index,
+                                                                   const size_t count)
+    {
+        obj* head = tc.free_list[index];
+        obj* tail = head;
+        for (size_t i = 1; i < count; ++i)
+            tail = tail->free_list_link;
+        tc.free_list[index] = tail->free_list_link;
+        tc.length[index] -= count;
+        central_list[index].push(head, tail);
+        count_shared_bytes(count * SizeClass::size(index), 0);
+        if constexpr (alloc_stats_enabled)
+            tc.counters.cached_bytes.sub(count * SizeClass::size(index));
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::thread_cache::thread_cache()
+    {
+        if constexpr (alloc_stats_enabled)
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            next = cache_registry;
+            if (nullptr != next)
+                next->prev = this;
+            cache_registry = this;
+        }
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::thread_cache::~thread_cache()
+    {
+        for (size_t i = 0; i < NFREELISTS; ++i)
+        {
+            if (0 != length[i])
+                release_to_central(*this, i, length[i]);
+        }
+
+        if constexpr (alloc_stats_enabled)
+        {
+            // 计数并入全局计数后再从登记表摘除，stats() 在任意时刻都不会漏算或重算
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            for (size_t i = 0; i < NFREELISTS; ++i)
+            {
+                global_counters.allocations[i].add(counters.allocations[i].load());
+                global_counters.deallocations[i].add(counters.deallocations[i].load());
+            }
+            global_counters.large_allocations.add(counters.large_allocations.load());
+            global_counters.large_deallocations.add(counters.large_deallocations.load());
+            global_counters.refills.add(counters.refills.load());
+            if (nullptr != prev)
+                prev->next = next;
+            else
+                cache_registry = next;
+            if (nullptr != next)
+                next->prev = prev;
+        }
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void default_alloc_template<threads, ints, SizeClass, ChunkSource>::collect(stats_type& result, const counters_type& counters)
+    {
+        for (size_t i = 0; i < NFREELISTS; ++i)
+        {
+            result.allocations[i] += counters.allocations[i].load();
+            result.deallocations[i] += counters.deallocations[i].load();
+        }
+        result.large_allocations += counters.large_allocations.load();
+        result.large_deallocations += counters.large_deallocations.load();
+        result.refills += counters.refills.load();
+        result.thread_cache_bytes += counters.cached_bytes.load();
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    typename default_alloc_template<threads, ints, SizeClass, ChunkSource>::stats_type
+    default_alloc_template<threads, ints, SizeClass, ChunkSource>::stats()
+    {
+        stats_type result;
+        if constexpr (alloc_stats_enabled)
+        {
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex);
+                collect(result, global_counters);
+                for (const thread_cache* tc = cache_registry; nullptr != tc; tc = tc->next)
+                    collect(result, tc->counters);
+            }
+            result.free_list_bytes = shared_free_bytes.load(std::memory_order_relaxed);
+            result.oom_handler_calls = malloc_alloc::stats().oom_handler_calls;
+
+            std::unique_lock<std::mutex> lock(central_mutex, std::defer_lock);
+            if constexpr (threads)
+                lock.lock();
+            result.chunk_allocs = chunk_allocs;
+            result.chunks_released = chunks_released;
+            result.mmap_chunks = chunk_origins[static_cast<size_t>(chunk_origin::mmap)];
+            result.huge_page_chunks = chunk_origins[static_cast<size_t>(chunk_origin::huge_page)];
+            result.pool_bytes = static_cast<size_t>(end_free - start_free);
+            result.heap_size = heap_size;
+        }
+        return result;
+    }
+
+
+    /**
+     * @brief 把内存块回收到自由链表，bytes 为池中块的请求大小（加固模式下已含保护字节）
+     */
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void default_alloc_template<threads, ints, SizeClass, ChunkSource>::deallocate_block(void* p, const size_t bytes)
+    {
+        obj* q = static_cast<obj*>(p); // 将指针转换为 obj*，以便操作链表
+        const size_t n = 0 == bytes ? 1 : bytes; // 与 allocate_block 一致，大小为 0 的块属于最小类别
+
+        // 如果内存块大于二级分配器管理的最大块，交给一级配置器释放
+        if (n > static_cast<size_t>(MAX_BYTES))
+        {
+            if constexpr (alloc_stats_enabled)
+                local_counters().large_deallocations.add(1);
+            malloc_alloc::deallocate(p, n);
+            return;
+        }
+
+        // 多线程模式：放回线程缓存，积压超过上限时归还一批给中心池
+        if constexpr (threads)
+        {
+            const size_t index = FREELIST_INDEX(n);
+            thread_cache& tc = cache;
+            if constexpr (alloc_stats_enabled)
+            {
+                tc.counters.deallocations[index].add(1);
+                tc.counters.cached_bytes.add(SizeClass::size(index));
+            }
+            q->free_list_link = tc.free_list[index];
+            tc.free_list[index] = q;
+            if (++tc.length[index] > list_limit(tc.batch[index], index))
+            {
+                // 释放多于分配：归还一个满批量给中心池，并收缩该类别的补充批量
+                release_to_central(tc, index, max_batch(index));
+                shrink_batch(tc.batch[index]);
+            }
+            return;
+        }
+
+        // 获取当前块对应的自由链表
         obj* volatile * my_free_list = free_list + FREELIST_INDEX(n);
+        if constexpr (alloc_stats_enabled)
+            global_counters.deallocations[FREELIST_INDEX(n)].add(1);
+        count_shared_bytes(CLASS_SIZE(n), 0);
 
-        // 第一块用于返回给用户，剩下的全部挂到自由链表上
-        obj* result = reinterpret_cast<obj*>(chunk); // 第一块作为返回值
-        *my_free_list = next_obj = reinterpret_cast<obj*>(chunk + n); // 第二块作为自由链表头节点
+        // 将当前块插入到自由链表头部，实现O(1)回收
+        q->free_list_link = *my_free_list; // 当前块指向链表原头
+        *my_free_list = q; // 当前块成为新的头节点
+        const size_t index = FREELIST_INDEX(n);
+        if (++free_length[index] > list_limit(refill_batch[index], index))
+            shrink_batch(refill_batch[index]); // 链表积压，说明补充过多
+    }
+
+
+    /**
+     * @brief 重新分配内存块
+     */
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void* default_alloc_template<threads, ints, SizeClass, ChunkSource>::reallocate(void* p, const size_t old_sz, const size_t new_sz)
+    {
+        // 情况1：新旧块都由一级配置器管理（加固模式下放不下保护字节的请求也是），直接调用一级配置器的reallocate
+        if constexpr (alloc_hardened_enabled)
+        {
+            if (!guarded(old_sz) && !guarded(new_sz))
+                return malloc_alloc::reallocate(p, old_sz, new_sz);
+        }
+        else if (old_sz > static_cast<size_t>(MAX_BYTES) && new_sz > static_cast<size_t>(MAX_BYTES))
+            return malloc_alloc::reallocate(p, old_sz, new_sz);
+
+        // 情况2：新旧大小属于同一类（在自由链表中的类别相同），直接复用原块；加固模式下块头记录了大小，不能复用
+        if (!alloc_hardened_enabled && old_sz <= static_cast<size_t>(MAX_BYTES) &&
+            new_sz <= static_cast<size_t>(MAX_BYTES) && FREELIST_INDEX(old_sz) == FREELIST_INDEX(new_sz))
+            return p;
+
+        // 情况3：需要分配新块，拷贝原有数据，释放旧块
+        void* result = allocate(new_sz); // 分配新块
+        if (result != nullptr)
+        {
+            // 只拷贝较小的一段数据，防止越界
+            const size_t copy_sz = new_sz > old_sz ? old_sz : new_sz;
+            std::memcpy(result, p, copy_sz);
+            deallocate(p, old_sz); // 回收旧块
+        }
+        return result;
+    }
+
+
+    /**
+     * @brief 从自由链表取出内存块，bytes 为池中块的请求大小（加固模式下已含保护字节）
+     */
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void* default_alloc_template<threads, ints, SizeClass, ChunkSource>::allocate_block(const size_t bytes)
+    {
+        obj* result = nullptr;
+        const size_t n = 0 == bytes ? 1 : bytes; // 大小为 0 时按最小类别分配，像 malloc(0) 一样返回唯一的指针
+
+        // 如果分配请求超过最大管理块，交由一级分配器处理
+        if (n > static_cast<size_t>(MAX_BYTES))
+        {
+            if constexpr (alloc_stats_enabled)
+                local_counters().large_allocations.add(1);
+            return (malloc_alloc::allocate(n));
+        }
+
+        // 多线程模式：从线程缓存取块，无需加锁
+        if constexpr (threads)
+        {
+            const size_t index = FREELIST_INDEX(n);
+            thread_cache& tc = cache;
+            if constexpr (alloc_stats_enabled)
+                tc.counters.allocations[index].add(1);
+            obj* head = tc.free_list[index];
+            if (nullptr == head)
+                return refill_cache(CLASS_SIZE(n));
+            tc.free_list[index] = head->free_list_link;
+            --tc.length[index];
+            if constexpr (alloc_stats_enabled)
+                tc.counters.cached_bytes.sub(SizeClass::size(index));
+            return head;
+        }
+
+        // 获取当前大小对应的自由链表
+        obj* volatile * my_free_list = free_list + FREELIST_INDEX(n);
+        if constexpr (alloc_stats_enabled)
+            global_counters.allocations[FREELIST_INDEX(n)].add(1);
+
+        result = *my_free_list; // 从自由链表头取出一个可用块
+
+        // 如果自由链表为空，则批量分配并补充链表
+        if (result == nullptr)
+        {
+            void* r = refill(CLASS_SIZE(n)); // refill 会返回一块新的内存，并补链
+            return r;
+        }
+
+        // 否则，链表不为空，将链表头移到下一个
+        *my_free_list = result->free_list_link;
+        --free_length[FREELIST_INDEX(n)];
+        count_shared_bytes(0, CLASS_SIZE(n));
+
+        // 返回从链表取出的内存块
+        return result;
+    }
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void default_alloc_template<threads, ints, SizeClass, ChunkSource>::allocate_batch(const size_t n, const size_t count,
+                                                                                    void** out)
+    {
+        size_t i = 0;
+        // 空请求不占用池中的块，与 simple_alloc 一致返回空指针
+        if (0 == n)
+        {
+            std::fill_n(out, count, nullptr);
+            return;
+        }
+        // 大块逐块处理；加固模式下每块都要单独写入保护字节
+        if (n > static_cast<size_t>(MAX_BYTES) || alloc_hardened_enabled)
+        {
+            try
+            {
+                for (; i < count; ++i)
+                    out[i] = allocate(n);
+            }
+            catch (...)
+            {
+                deallocate_batch(n, i, out);
+                throw;
+            }
+            return;
+        }
+
+        const size_t index = FREELIST_INDEX(n);
+        const size_t size = SizeClass::size(index);
+        if constexpr (threads)
+        {
+            // 先摘线程缓存，再从中心链表整段弹出
+            thread_cache& tc = cache;
+            obj* head = tc.free_list[index];
+            for (; i < count && nullptr != head; ++i, head = head->free_list_link)
+                out[i] = head;
+            tc.free_list[index] = head;
+            tc.length[index] -= i;
+            if constexpr (alloc_stats_enabled)
+                tc.counters.cached_bytes.sub(i * size);
+            if (i < count)
+            {
+                size_t popped = 0;
+                const unsigned epoch = reader_epoch.load() & 1;
+                readers[epoch].fetch_add(1);
+                obj* chain = central_list[index].pop(count - i, popped);
+                readers[epoch].fetch_sub(1);
+                for (; nullptr != chain; chain = chain->free_list_link)
+                    out[i++] = chain;
+                count_shared_bytes(0, popped * size);
+            }
+        }
+        else
+        {
+            obj* head = free_list[index];
+            for (; i < count && nullptr != head; ++i, head = head->free_list_link)
+                out[i] = head;
+            free_list[index] = head;
+            free_length[index] -= i;
+            count_shared_bytes(0, i * size);
+        }
+
+        // 自由链表不足：从内存池连续切分剩余的块，每次至多 MAX_CARVE_BYTES 字节
+        if (i < count)
+        {
+            try
+            {
+                std::unique_lock<std::mutex> lock(central_mutex, std::defer_lock);
+                if constexpr (threads)
+                    lock.lock();
+                while (i < count)
+                {
+                    int nobjs = static_cast<int>(std::min<size_t>(count - i, std::max<size_t>(MAX_CARVE_BYTES / size, 1)));
+                    char* chunk = chunk_alloc(size, nobjs);
+                    for (int k = 0; k < nobjs; ++k)
+                        out[i++] = chunk + k * size;
+                }
+            }
+            catch (...)
+            {
+                if constexpr (alloc_stats_enabled)
+                    local_counters().allocations[index].add(i); // 与 deallocate_batch 计入的释放次数配对
+                deallocate_batch(n, i, out);
+                throw;
+            }
+        }
+
+        if constexpr (alloc_stats_enabled)
+            local_counters().allocations[index].add(count);
+        for (size_t k = 0; k < count; ++k)
+            profile(out[k], n);
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void default_alloc_template<threads, ints, SizeClass, ChunkSource>::deallocate_batch(const size_t n, const size_t count,
+                                                                                      void* const* ptrs)
+    {
+        if (0 == n)
+            return;
+        if (n > static_cast<size_t>(MAX_BYTES) || alloc_hardened_enabled)
+        {
+            for (size_t k = 0; k < count; ++k)
+                deallocate(ptrs[k], n);
+            return;
+        }
+        if (0 == count)
+            return;
+
+        const size_t index = FREELIST_INDEX(n);
+        const size_t size = SizeClass::size(index);
+        obj* first = static_cast<obj*>(ptrs[0]);
+        obj* last = first;
+        heap_profiler::on_deallocate(first);
+        for (size_t k = 1; k < count; ++k)
+        {
+            heap_profiler::on_deallocate(ptrs[k]);
+            obj* p = static_cast<obj*>(ptrs[k]);
+            last->free_list_link = p;
+            last = p;
+        }
+
+        if constexpr (threads)
+        {
+            thread_cache& tc = cache;
+            if constexpr (alloc_stats_enabled)
+            {
+                tc.counters.deallocations[index].add(count);
+                tc.counters.cached_bytes.add(count * size);
+            }
+            last->free_list_link = tc.free_list[index];
+            tc.free_list[index] = first;
+            tc.length[index] += count;
+            // 积压时把超出一个批量的部分归还中心池
+            if (tc.length[index] > list_limit(tc.batch[index], index))
+            {
+                release_to_central(tc, index, tc.length[index] - tc.batch[index]);
+                shrink_batch(tc.batch[index]);
+            }
+        }
+        else
+        {
+            if constexpr (alloc_stats_enabled)
+                global_counters.deallocations[index].add(count);
+            count_shared_bytes(count * size, 0);
+            last->free_list_link = free_list[index];
+            free_list[index] = first;
+            free_length[index] += count;
+            if (free_length[index] > list_limit(refill_batch[index], index))
+                shrink_batch(refill_batch[index]);
+        }
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void* default_alloc_template<threads, ints, SizeClass, ChunkSource>::allocate_aligned(const size_t n, const size_t align)
+    {
+        if (align <= ALIGN)
+            return allocate(n);
+        if (n + align > MAX_BYTES)
+            return malloc_alloc::allocate_aligned(n, align);
+        return align_and_record(allocate(n + align), align);
+    }
+
+
+    template <bool threads, int ints, typename SizeClass, typename ChunkSource>
+    void default_alloc_template<threads, ints, SizeClass, ChunkSource>::deallocate_aligned(void* p, const size_t n,
+                                                                                        const size_t align)
+    {
+        if (align <= ALIGN)
+            deallocate(p, n);
+        else if (n + align > MAX_BYTES)
+            malloc_alloc::deallocate_aligned(p, n, align);
+        else
+            deallocate(aligned_origin(p), n + align);
+    }
+
+    using alloc = default_alloc_template<false, 0>; ///<默认分配器类型别名
+
+    using mt_alloc = default_alloc_template<true, 0>; ///<多线程分配器类型别名，可在 ThreadPool 工作线程中使用
+
+    /**
+     * @brief 分配器保证的对齐：有 ALIGN 成员时取其值，否则视为与 malloc 相同
+     */
+    template <typename Alloc, typename = void>
+    struct alloc_alignment : std::integral_constant<size_t, alignof(std::max_align_t)>
+    {
+    };
+
+    template <typename Alloc>
+    struct alloc_alignment<Alloc, std::void_t<decltype(Alloc::ALIGN)>>
+        : std::integral_constant<size_t, static_cast<size_t>(Alloc::ALIGN)>
+    {
+    };
+
+    /**
+     * @brief 判断 T 能否按字节搬迁：memcpy 到新地址后直接丢弃旧对象，而不调用移动构造与析构
+     *
+     * 默认对可平凡移动构造且可平凡析构的类型（包括 std::pair<int, int> 这类赋值运算符非平凡的类型）成立；
+     * 用户可为满足该性质的其他类型特化为 true_type。
+     */
+    template <typename T>
+    struct is_trivially_relocatable
+        : std::bool_constant<std::is_trivially_move_constructible<T>::value && std::is_trivially_destructible<T>::value>
+    {
+    };
+
+    /**
+     * @brief 判断分配策略是否提供 allocate_batch / deallocate_batch
+     */
+    template <typename Alloc, typename = void>
+    struct has_batch_alloc : std::false_type
+    {
+    };
+
+    template <typename Alloc>
+    struct has_batch_alloc<Alloc, std::void_t<decltype(std::declval<const Alloc&>().allocate_batch(
+                                      size_t(), size_t(), static_cast<void**>(nullptr)))>> : std::true_type
+    {
+    };
+
+    /**
+     * @brief 判断分配策略能否报告请求的实际块大小（good_size）
+     */
+    template <typename Alloc, typename = void>
+    struct has_good_size : std::false_type
+    {
+    };
+
+    template <typename Alloc>
+    struct has_good_size<Alloc, std::void_t<decltype(std::declval<const Alloc&>().good_size(size_t()))>>
+        : std::true_type
+    {
+    };
+
+    /**
+     * @brief 判断分配策略能否被多个线程同时调用：声明了 THREAD_SAFE 且为 true
+     */
+    template <typename Alloc, typename = void>
+    struct is_thread_safe_alloc : std::false_type
+    {
+    };
+
+    template <typename Alloc>
+    struct is_thread_safe_alloc<Alloc, std::void_t<decltype(Alloc::THREAD_SAFE)>>
+        : std::bool_constant<Alloc::THREAD_SAFE>
+    {
+    };
+
+    /**
+     * @brief 通用对象分配器模板
+     *
+     * 不带分配器参数的接口用于静态分配策略（alloc、mt_alloc、arena_alloc 等）；
+     * 带 const Alloc& 参数的接口用于分配器实例（例如 polymorphic_alloc），对静态策略同样适用。
+     * alignof(T) 超过分配器保证的对齐时，自动改用 allocate_aligned / deallocate_aligned。
+     */
+    template <typename T, typename Alloc>
+    class simple_alloc
+    {
+    private:
+        static constexpr bool over_aligned = alignof(T) > alloc_alignment<Alloc>::value; ///< 是否需要对齐分配
+        static constexpr size_t BATCH = 64; ///< 批量接口每次交给分配器的块数，对应栈上的指针缓冲
+
+        static T* allocate_bytes(const Alloc& a, const size_t bytes)
+        {
+            if constexpr (over_aligned)
+                return static_cast<T*>(a.allocate_aligned(bytes, alignof(T)));
+            else
+                return static_cast<T*>(a.allocate(bytes));
+        }
+
+        static void deallocate_bytes(const Alloc& a, T* p, const size_t bytes)
+        {
+            if constexpr (over_aligned)
+                a.deallocate_aligned(p, bytes, alignof(T));
+            else
+                a.deallocate(p, bytes);
+        }
+
+    public:
+        /**
+         * @brief 通过分配器实例分配 n 个 T 类型对象的内存
+         */
+        static T* allocate(const Alloc& a, const size_t n)
+        {
+            return 0 == n ? nullptr : allocate_bytes(a, n * sizeof(T));
+        }
+
+        /**
+         * @brief 通过分配器实例分配单个 T 类型对象的内存
+         */
+        static T* allocate(const Alloc& a)
+        {
+            return allocate_bytes(a, sizeof(T));
+        }
+
+        /**
+         * @brief 通过分配器实例释放 n 个 T 类型对象占用的内存
+         */
+        static void deallocate(const Alloc& a, T* p, const size_t n)
+        {
+            if (0 != n)
+                deallocate_bytes(a, p, n * sizeof(T));
+        }
+
+        /**
+         * @brief 通过分配器实例释放单个 T 类型对象占用的内存
+         */
+        static void deallocate(const Alloc& a, T* p)
+        {
+            deallocate_bytes(a, p, sizeof(T));
+        }
+
+        /**
+         * @brief 通过分配器实例一次分配 count 块、每块 n 个 T 对象的内存，写入 out[0, count)
+         *
+         * 分配器提供 allocate_batch 时按批交给它，否则逐块分配；任一块失败时已分配的块全部释放并重新抛出异常。
+         */
+        static void allocate_batch(const Alloc& a, const size_t n, const size_t count, T** out)
+        {
+            size_t done = 0;
+            try
+            {
+                if constexpr (!over_aligned && has_batch_alloc<Alloc>::value)
+                {
+                    void* buffer[BATCH];
+                    while (done < count)
+                    {
+                        const size_t k = std::min(count - done, BATCH);
+                        a.allocate_batch(n * sizeof(T), k, buffer);
+                        for (size_t i = 0; i < k; ++i)
+                            out[done + i] = static_cast<T*>(buffer[i]);
+                        done += k;
+                    }
+                }
+                else
+                {
+                    for (; done < count; ++done)
+                        out[done] = allocate_bytes(a, n * sizeof(T));
+                }
+            }
+            catch (...)
+            {
+                deallocate_batch(a, n, done, out);
+                throw;
+            }
+        }
 
-        // 遍历剩余的块，将它们串联进自由链表
-        for (int i = 1;; ++i)
+        /**
+         * @brief 通过分配器实例一次释放 ptrs[0, count) 中的 count 块、每块 n 个 T 对象的内存
+         */
+        static void deallocate_batch(const Alloc& a, const size_t n, const size_t count, T* const* ptrs)
         {
-            obj* current_obj = next_obj;
-            next_obj = reinterpret_cast<obj*>(reinterpret_cast<char*>(next_obj) + n); // 指向下一个块
-            if (nobjs - 1 == i) // 最后一块
+            if constexpr (!over_aligned && has_batch_alloc<Alloc>::value)
             {
-                current_obj->free_list_link = nullptr; // 尾节点next为null
-                break;
+                void* buffer[BATCH];
+                for (size_t done = 0; done < count;)
+                {
+                    const size_t k = std::min(count - done, BATCH);
+                    for (size_t i = 0; i < k; ++i)
+                        buffer[i] = ptrs[done + i];
+                    a.deallocate_batch(n * sizeof(T), k, buffer);
+                    done += k;
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < count; ++i)
+                    deallocate_bytes(a, ptrs[i], n * sizeof(T));
             }
-            current_obj->free_list_link = next_obj; // 挂接链表
         }
-        return result; // 返回第一块，供本次分配使用
-    }
 
+        /**
+         * @brief 通过分配器实例把 old_n 个对象的空间调整为 new_n 个，按字节搬迁原有内容
+         *
+         * 只适用于可按字节搬迁的类型。大块交给一级配置器的 realloc，可能原地扩展或由 mremap 完成；
+         * 超对齐类型无法保证 realloc 后的对齐，改为分配、拷贝、释放。
+         */
+        static T* reallocate(const Alloc& a, T* p, const size_t old_n, const size_t new_n)
+        {
+            static_assert(is_trivially_relocatable<T>::value, "reallocate requires a trivially relocatable type");
+            if (nullptr == p || 0 == old_n)
+                return allocate(a, new_n);
+            if constexpr (over_aligned)
+            {
+                T* result = allocate(a, new_n);
+                std::memcpy(static_cast<void*>(result), p, (old_n < new_n ? old_n : new_n) * sizeof(T));
+                deallocate(a, p, old_n);
+                return result;
+            }
+            else
+                return static_cast<T*>(a.reallocate(p, old_n * sizeof(T), new_n * sizeof(T)));
+        }
 
-    /**
-     * @brief 释放内存并回收到自由链表
-     */
-    template <bool threads, int ints>
-    void default_alloc_template<threads, ints>::deallocate(void* p, const size_t n)
-    {
-        obj* q = static_cast<obj*>(p); // 将指针转换为 obj*，以便操作链表
+        /**
+         * @brief 通过分配器实例计算请求 n 个对象时实际取得的块能容纳的对象数（不小于 n）
+         *
+         * 分配器不提供 good_size 或需要对齐分配时原样返回 n。
+         */
+        static size_t good_size(const Alloc& a, const size_t n)
+        {
+            if constexpr (has_good_size<Alloc>::value && !over_aligned)
+            {
+                const size_t granted = a.good_size(n * sizeof(T)) / sizeof(T);
+                return granted > n ? granted : n;
+            }
+            else
+            {
+                static_cast<void>(a);
+                return n;
+            }
+        }
 
-        // 如果内存块大于二级分配器管理的最大块，交给一级配置器释放
-        if (n > static_cast<size_t>(MAX_BYTES))
+        /**
+         * @brief 分配 n 个 T 类型对象的内存
+         */
+        static T* allocate(const size_t n)
         {
-            malloc_alloc::deallocate(p, n);
-            return;
+            return allocate(Alloc(), n);
         }
 
-        // 获取当前块对应的自由链表
-        obj* volatile * my_free_list = free_list + FREELIST_INDEX(n);
+        /**
+         * @brief 分配单个 T 类型对象的内存
+         */
+        static T* allocate()
+        {
+            return allocate(Alloc());
+        }
 
-        // 将当前块插入到自由链表头部，实现O(1)回收
-        q->free_list_link = *my_free_list; // 当前块指向链表原头
-        *my_free_list = q; // 当前块成为新的头节点
-    }
+        /**
+         * @brief 释放 n 个 T 类型对象占用的内存
+         */
+        static void deallocate(T* p, const size_t n)
+        {
+            deallocate(Alloc(), p, n);
+        }
 
+        /**
+         * @brief 释放单个 T 类型对象占用的内存
+         */
+        static void deallocate(T* p)
+        {
+            deallocate(Alloc(), p);
+        }
 
-    /**
-     * @brief 重新分配内存块
-     */
-    template <bool threads, int ints>
-    void* default_alloc_template<threads, ints>::reallocate(void* p, const size_t old_sz, const size_t new_sz)
-    {
-        // 情况1：新旧大小都超出二级分配器管理范围，直接调用一级配置器的reallocate
-        if (old_sz > static_cast<size_t>(MAX_BYTES) && new_sz > static_cast<size_t>(MAX_BYTES))
-            return malloc_alloc::reallocate(p, old_sz, new_sz);
+        /**
+         * @brief 一次分配 count 块、每块 n 个 T 对象的内存
+         */
+        static void allocate_batch(const size_t n, const size_t count, T** out)
+        {
+            allocate_batch(Alloc(), n, count, out);
+        }
 
-        // 情况2：新旧大小对齐后属于同一类（在自由链表中的类别相同），直接复用原块
-        if (ROUND_UP(old_sz) == ROUND_UP(new_sz))
-            return p;
+        /**
+         * @brief 一次释放 count 块、每块 n 个 T 对象的内存
+         */
+        static void deallocate_batch(const size_t n, const size_t count, T* const* ptrs)
+        {
+            deallocate_batch(Alloc(), n, count, ptrs);
+        }
 
-        // 情况3：需要分配新块，拷贝原有数据，释放旧块
-        void* result = allocate(new_sz); // 分配新块
-        if (result != nullptr)
+        /**
+         * @brief 把 old_n 个对象的空间调整为 new_n 个，按字节搬迁原有内容
+         */
+        static T* reallocate(T* p, const size_t old_n, const size_t new_n)
         {
-            // 只拷贝较小的一段数据，防止越界
-            const size_t copy_sz = new_sz > old_sz ? old_sz : new_sz;
-            std::memcpy(result, p, copy_sz);
-            deallocate(p, old_sz); // 回收旧块
+            return reallocate(Alloc(), p, old_n, new_n);
         }
-        return result;
-    }
+    };
 
 
     /**
-     * @brief 分配内存块
+     * @brief 容器的分配器基类：保存容器使用的分配器实例
+     *
+     * 有状态的分配器（如 polymorphic_alloc）作为成员保存；无状态的分配器（空类，包括全部静态分配策略）
+     * 不占用任何空间，容器以它为空基类，大小与只支持静态策略时相同。
      */
-    template <bool threads, int ints>
-    void* default_alloc_template<threads, ints>::allocate(const size_t n)
+    template <typename Alloc, bool = std::is_empty<Alloc>::value>
+    class alloc_base
     {
-        obj* result = nullptr;
-
-        // 如果分配请求超过最大管理块，交由一级分配器处理
-        if (n > static_cast<size_t>(MAX_BYTES))
-            return (malloc_alloc::allocate(n));
-
-        // 获取当前大小对应的自由链表
-        obj* volatile * my_free_list = free_list + FREELIST_INDEX(n);
-
-        result = *my_free_list; // 从自由链表头取出一个可用块
+    public:
+        typedef Alloc allocator_type;
 
-        // 如果自由链表为空，则批量分配并补充链表
-        if (result == nullptr)
+        explicit alloc_base(const Alloc& a = Alloc()) : m_alloc(a)
         {
-            void* r = refill(ROUND_UP(n)); // refill 会返回一块新的内存，并补链
-            return r;
         }
 
-        // 否则，链表不为空，将链表头移到下一个
-        *my_free_list = result->free_list_link;
+        /**
+         * @brief 返回容器使用的分配器
+         */
+        allocator_type get_allocator() const
+        {
+            return m_alloc;
+        }
 
-        // 返回从链表取出的内存块
-        return result;
-    }
+    protected:
+        const Alloc& allocator() const
+        {
+            return m_alloc;
+        }
 
-    using alloc = default_alloc_template<false, 0>; ///<默认分配器类型别名
+    private:
+        Alloc m_alloc; ///< 分配器实例
+    };
 
     /**
-     * @brief 通用对象分配器模板
+     * @brief 无状态分配器的特化：不保存任何数据，所有实例等价
      */
-    template <typename T, typename Alloc>
-    class simple_alloc
+    template <typename Alloc>
+    class alloc_base<Alloc, true>
     {
     public:
-        /**
-         * @brief 分配 n 个 T 类型对象的内存
-         */
-        static T* allocate(const size_t n)
-        {
-            return 0 == n ? nullptr : reinterpret_cast<T*>(Alloc::allocate(n * sizeof(T)));
-        }
+        typedef Alloc allocator_type;
 
-        /**
-         * @brief 分配单个 T 类型对象的内存
-         */
-        static T* allocate()
+        explicit alloc_base(const Alloc& = Alloc())
         {
-            return static_cast<T*>(Alloc::allocate(sizeof(T)));
         }
 
         /**
-         * @brief 释放 n 个 T 类型对象占用的内存
+         * @brief 返回容器使用的分配器
          */
-        static void deallocate(T* p, const size_t n)
+        allocator_type get_allocator() const
         {
-            if (0 != n)
-            {
-                Alloc::deallocate(p, n * sizeof(T));
-            }
+            return Alloc();
         }
 
-        /**
-         * @brief 释放单个 T 类型对象占用的内存
-         */
-        static void deallocate(T* p)
+    protected:
+        static Alloc allocator()
         {
-            Alloc::deallocate(p, sizeof(T));
+            return Alloc();
         }
     };
 
@@ -463,8 +2103,16 @@ namespace Tiny
     ForwardIterator uninitialized_fill_n_aux_(ForwardIterator first, Size n, const T& x, false_type)
     {
         ForwardIterator cur = first;
-        for (; n > 0; --n, ++cur)
-            construct(&*cur, x); // 在指定位置构造对象
+        try
+        {
+            for (; n > 0; --n, ++cur)
+                construct(&*cur, x); // 在指定位置构造对象
+        }
+        catch (...)
+        {
+            Tiny::destroy(first, cur); // 构造失败时销毁已构造的对象
+            throw;
+        }
         return cur;
     }
 
@@ -474,7 +2122,32 @@ namespace Tiny
     template <typename ForwardIterator, typename Size, typename T>
     ForwardIterator uninitialized_fill_n_aux_(ForwardIterator first, Size n, const T& x, true_type)
     {
-        return std::fill_n(first, n, x);
+        typedef typename std::remove_pointer<ForwardIterator>::type element_type;
+        if constexpr (std::is_pointer<ForwardIterator>::value && stream_fillable(sizeof(element_type)))
+        {
+            // 大区间使用非临时存储，例如初始化数 MB 的 vector<float> 时不会驱逐热数据
+            if (n > 0 && static_cast<size_t>(n) * sizeof(element_type) >= STREAMING_THRESHOLD)
+            {
+                const element_type value = x;
+                stream_fill(first, &value, sizeof(element_type), static_cast<size_t>(n));
+                return first + n;
+            }
+        }
+        if constexpr (std::is_trivially_copy_constructible<T>::value && std::is_trivially_destructible<T>::value)
+        {
+            // 局部副本不会与目标区间别名；平凡拷贝构造即逐字节写入，不经过可能非平凡的赋值运算符，编译器可以向量化
+            const T value = x;
+            for (; n > 0; --n, ++first)
+                construct(&*first, value);
+            return first;
+        }
+        else
+        {
+            // 目标类型只保证拷贝构造平凡，赋值运算符可能是用户定义的，不能对未初始化内存赋值；目标可平凡析构，无需回滚
+            for (; n > 0; --n, ++first)
+                construct(&*first, x);
+            return first;
+        }
     }
 
     /**
@@ -524,13 +2197,29 @@ namespace Tiny
     uninitialized_copy_aux_(InputIterator first, InputIterator last, ForwardIterator result, false_type)
     {
         ForwardIterator cur = result;
-        for (; first != last; ++first, ++cur)
+        try
         {
-            construct(&*cur, *first); // 对目标内存逐个构造新对象
+            for (; first != last; ++first, ++cur)
+            {
+                construct(&*cur, *first); // 对目标内存逐个构造新对象
+            }
+        }
+        catch (...)
+        {
+            Tiny::destroy(result, cur); // 构造失败时销毁已构造的对象
+            throw;
         }
         return cur;
     }
 
+    /**
+     * @brief 源与目标都是指向同一类型的指针时可整体 memmove
+     */
+    template <typename InputIterator, typename ForwardIterator>
+    constexpr bool is_memmovable_range = std::is_pointer<InputIterator>::value && std::is_pointer<ForwardIterator>::value &&
+        std::is_same<typename std::remove_cv<typename std::remove_pointer<InputIterator>::type>::type,
+                     typename std::remove_pointer<ForwardIterator>::type>::value;
+
     /**
      * @brief 针对POD类型，在未初始化内存区域批量拷贝
      */
@@ -538,7 +2227,29 @@ namespace Tiny
     ForwardIterator
     uninitialized_copy_aux_(InputIterator first, InputIterator last, ForwardIterator result, true_type)
     {
-        return std::copy(first, last, result);
+        if constexpr (is_memmovable_range<InputIterator, ForwardIterator>)
+        {
+            const auto n = last - first;
+            if (n > 0)
+            {
+                // 大区间且不重叠时使用流式拷贝，避免把整段目标写入缓存、挤掉热数据
+                const size_t bytes = n * sizeof(*first);
+                const auto src = reinterpret_cast<uintptr_t>(first);
+                const auto dst = reinterpret_cast<uintptr_t>(result);
+                if (bytes >= STREAMING_THRESHOLD && (dst + bytes <= src || src + bytes <= dst))
+                    stream_copy(result, first, bytes);
+                else
+                    std::memmove(static_cast<void*>(result), first, bytes);
+            }
+            return result + n;
+        }
+        else
+        {
+            // 同 uninitialized_fill_n_aux_：逐个构造而不是赋值
+            for (; first != last; ++first, ++result)
+                construct(&*result, *first);
+            return result;
+        }
     }
 
     /**
@@ -568,7 +2279,19 @@ namespace Tiny
     void
     uninitialized_fill_aux_(ForwardIterator first, ForwardIterator last, const T& x, true_type)
     {
-        std::fill(first, last, x); // 直接批量赋值
+        if constexpr (std::is_pointer<ForwardIterator>::value)
+            uninitialized_fill_n_aux_(first, last - first, x, true_type());
+        else if constexpr (std::is_trivially_copy_constructible<T>::value && std::is_trivially_destructible<T>::value)
+        {
+            const T value = x; // 同 uninitialized_fill_n_aux_：局部副本加平凡拷贝构造
+            for (; first != last; ++first)
+                construct(&*first, value);
+        }
+        else
+        {
+            for (; first != last; ++first)
+                construct(&*first, x); // 逐个构造，不经过可能非平凡的赋值运算符
+        }
     }
 
     /**
@@ -579,8 +2302,16 @@ namespace Tiny
     uninitialized_fill_aux_(ForwardIterator first, ForwardIterator last, const T& x, false_type)
     {
         ForwardIterator cur = first;
-        for (; cur != last; ++cur)
-            construct(&*cur, x); // 手动构造每一个对象
+        try
+        {
+            for (; cur != last; ++cur)
+                construct(&*cur, x); // 手动构造每一个对象
+        }
+        catch (...)
+        {
+            Tiny::destroy(first, cur); // 构造失败时销毁已构造的对象
+            throw;
+        }
     }
 
     /**
@@ -601,6 +2332,131 @@ namespace Tiny
     {
         uninitialized_fill_(first, last, x, value_type(first));
     }
+
+    /**
+     * @brief 在未初始化区间[first, last)逐个默认初始化（不是值初始化），可平凡默认构造的类型不写入任何内容；
+     *        某个构造抛出异常时销毁已构造的元素
+     */
+    template <typename ForwardIterator>
+    void uninitialized_default_construct(ForwardIterator first, ForwardIterator last)
+    {
+        typedef typename iterator_traits<ForwardIterator>::value_type T;
+        if constexpr (!std::is_trivially_default_constructible<T>::value)
+        {
+            ForwardIterator cur = first;
+            try
+            {
+                for (; cur != last; ++cur)
+                    ::new(static_cast<void*>(&*cur)) T;
+            }
+            catch (...)
+            {
+                Tiny::destroy(first, cur);
+                throw;
+            }
+        }
+        else
+        {
+            static_cast<void>(first);
+            static_cast<void>(last);
+        }
+    }
+
+
+    /**
+     * @brief 针对非POD类型，在未初始化内存区域逐个移动构造；某个构造抛出异常时销毁已构造的元素
+     */
+    template <typename InputIterator, typename ForwardIterator>
+    ForwardIterator
+    uninitialized_move_aux_(InputIterator first, InputIterator last, ForwardIterator result, false_type)
+    {
+        ForwardIterator cur = result;
+        try
+        {
+            for (; first != last; ++first, ++cur)
+                construct(&*cur, std::move(*first));
+        }
+        catch (...)
+        {
+            Tiny::destroy(result, cur);
+            throw;
+        }
+        return cur;
+    }
+
+    /**
+     * @brief 针对POD类型，移动即拷贝，批量完成
+     */
+    template <typename InputIterator, typename ForwardIterator>
+    ForwardIterator
+    uninitialized_move_aux_(InputIterator first, InputIterator last, ForwardIterator result, true_type)
+    {
+        return uninitialized_copy_aux_(first, last, result, true_type());
+    }
+
+    /**
+     * @brief 内部辅助：根据目标类型选择合适的移动方式
+     */
+    template <typename InputIterator, typename ForwardIterator, typename T>
+    ForwardIterator uninitialized_move_(InputIterator first, InputIterator last, ForwardIterator result, T*)
+    {
+        typedef typename type_traits<T>::is_POD_type is_POD;
+        return uninitialized_move_aux_(first, last, result, is_POD());
+    }
+
+    /**
+     * @brief 外部接口：把区间[first, last)的元素移动构造到未初始化内存区域，源元素保留为被移动后的状态
+     */
+    template <typename InputIterator, typename ForwardIterator>
+    ForwardIterator uninitialized_move(InputIterator first, InputIterator last, ForwardIterator result)
+    {
+        return uninitialized_move_(first, last, result, value_type(result));
+    }
+
+    /**
+     * @brief 内部辅助：移动构造不会抛出异常（或类型不可拷贝）时移动，否则拷贝
+     */
+    template <typename InputIterator, typename ForwardIterator, typename T>
+    ForwardIterator uninitialized_move_if_noexcept_(InputIterator first, InputIterator last, ForwardIterator result, T*)
+    {
+        if constexpr (std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value)
+            return Tiny::uninitialized_move(first, last, result);
+        else
+            return Tiny::uninitialized_copy(first, last, result);
+    }
+
+    /**
+     * @brief 外部接口：与 std::move_if_noexcept 相同的选择规则，保证搬迁失败时源区间完好，
+     *        容器扩容因此可以在移动元素的同时维持强异常保证
+     */
+    template <typename InputIterator, typename ForwardIterator>
+    ForwardIterator uninitialized_move_if_noexcept(InputIterator first, InputIterator last, ForwardIterator result)
+    {
+        return uninitialized_move_if_noexcept_(first, last, result, value_type(result));
+    }
+
+    /**
+     * @brief 外部接口：把[first, last)的对象搬迁到不重叠的未初始化内存 result，源对象随后视为已销毁
+     *
+     * 可按字节搬迁的类型直接 memcpy 且不调用析构函数；其他类型按 uninitialized_move_if_noexcept
+     * 搬迁后析构源对象，搬迁失败时源区间保持不变。
+     */
+    template <typename T>
+    T* uninitialized_relocate(T* first, T* last, T* result)
+    {
+        if constexpr (is_trivially_relocatable<T>::value)
+        {
+            if (first != last)
+                std::memcpy(static_cast<void*>(result), first, (last - first) * sizeof(T));
+            return result + (last - first);
+        }
+        else
+        {
+            T* cur = Tiny::uninitialized_move_if_noexcept(first, last, result);
+            Tiny::destroy(first, last);
+            return cur;
+        }
+    }
 }
 
 
@@ -0,0 +1,310 @@
+#ifndef TINY_STL_ARENA_HPP
+#define TINY_STL_ARENA_HPP
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "allocator.hpp"
+
+namespace Tiny
+{
+    /**
+     * @brief 单调（bump-pointer）内存区：分配只移动指针，释放为空操作，reset() 一次性回收全部内存
+     *
+     * 内存块（block）向一级配置器申请并串成链表；reset() 只把指针拨回第一个块，已申请的块全部保留，
+     * 之后的分配按顺序复用，因此对请求级的“大量构造、整体丢弃”负载，稳态下不再向系统申请内存。
+     * 仅 deallocate 最近一次分配的内存时才会回退指针，其余释放都等到 reset()。
+     */
+    class arena
+    {
+    public:
+        static constexpr size_t ALIGN = alignof(std::max_align_t); ///< 分配结果的对齐边界
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024; ///< 默认的首个内存块大小
+        static constexpr size_t MAX_BLOCK_SIZE = 4 * 1024 * 1024; ///< 内存块大小几何增长的上限
+
+        /**
+         * @brief 构造空内存区，首次分配时才申请内存块
+         * @param block_size 首个内存块的可用字节数，之后的块逐次翻倍直到 MAX_BLOCK_SIZE
+         */
+        explicit arena(const size_t block_size = DEFAULT_BLOCK_SIZE) : m_next_size(block_size)
+        {
+        }
+
+        ~arena()
+        {
+            release();
+        }
+
+        arena(const arena&) = delete;
+
+        arena& operator=(const arena&) = delete;
+
+        /**
+         * @brief 分配 n 字节，结果按 ALIGN 对齐
+         */
+        void* allocate(size_t n)
+        {
+            n = round_up(n);
+            if (static_cast<size_t>(m_end - m_ptr) < n)
+                return allocate_slow(n);
+            void* result = m_ptr;
+            m_ptr += n;
+            return result;
+        }
+
+        /**
+         * @brief 按 align 对齐分配 n 字节（align 为 2 的幂），对齐产生的空隙在 reset() 时一并回收
+         */
+        void* allocate_aligned(const size_t n, const size_t align)
+        {
+            if (align <= ALIGN)
+                return allocate(n);
+            auto p = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(m_ptr) + align - 1) & ~(uintptr_t(align) - 1));
+            if (nullptr != m_ptr && p <= m_end && static_cast<size_t>(m_end - p) >= round_up(n))
+            {
+                m_ptr = p + round_up(n);
+                return p;
+            }
+            return align_and_record(allocate(n + align), align); // 换块时多取 align 字节，在新块中对齐
+        }
+
+        /**
+         * @brief 释放 allocate_aligned 分配的内存：与 deallocate 相同，留待 reset()
+         */
+        void deallocate_aligned(void* /** p */, size_t /** n */, size_t /** align */)
+        {
+        }
+
+        /**
+         * @brief 释放内存：仅当 p 是最近一次分配的内存时回退指针，否则留待 reset()
+         */
+        void deallocate(void* p, const size_t n)
+        {
+            if (static_cast<char*>(p) + round_up(n) == m_ptr)
+                m_ptr = static_cast<char*>(p);
+        }
+
+        /**
+         * @brief 重新分配：p 是最近一次分配且当前块空间足够时原地伸缩，否则分配新内存并拷贝
+         */
+        void* reallocate(void* p, const size_t old_sz, const size_t new_sz)
+        {
+            char* q = static_cast<char*>(p);
+            if (nullptr != q && q + round_up(old_sz) == m_ptr && static_cast<size_t>(m_end - q) >= round_up(new_sz))
+            {
+                m_ptr = q + round_up(new_sz);
+                return p;
+            }
+            void* result = allocate(new_sz);
+            if (nullptr != q)
+                std::memcpy(result, q, old_sz < new_sz ? old_sz : new_sz);
+            return result;
+        }
+
+        /**
+         * @brief 回收全部分配，保留已申请的内存块供复用，O(1)
+         */
+        void reset()
+        {
+            m_current = m_head;
+            m_ptr = nullptr == m_head ? nullptr : begin(m_head);
+            m_end = nullptr == m_head ? nullptr : begin(m_head) + m_head->size;
+        }
+
+        /**
+         * @brief 回收全部分配并把内存块归还系统
+         */
+        void release()
+        {
+            while (nullptr != m_head)
+            {
+                block* next = m_head->next;
+                malloc_alloc::deallocate(m_head, BLOCK_HEADER + m_head->size);
+                m_head = next;
+            }
+            m_current = nullptr;
+            m_ptr = m_end = nullptr;
+            m_capacity = 0;
+        }
+
+        /**
+         * @brief 已申请的内存块总字节数（不含块头）
+         */
+        [[nodiscard]] size_t capacity() const
+        {
+            return m_capacity;
+        }
+
+    private:
+        /**
+         * @brief 内存块头，位于每个内存块起始处
+         */
+        struct block
+        {
+            block* next; ///< 下一个内存块
+            size_t size; ///< 块头之后可用的字节数
+        };
+
+        ///< 块头占用的字节数，保证其后的内存满足对齐要求
+        static constexpr size_t BLOCK_HEADER = (sizeof(block) + ALIGN - 1) & ~(ALIGN - 1);
+
+        static size_t round_up(const size_t bytes)
+        {
+            return (bytes + ALIGN - 1) & ~(ALIGN - 1);
+        }
+
+        static char* begin(block* b)
+        {
+            return reinterpret_cast<char*>(b) + BLOCK_HEADER;
+        }
+
+        /**
+         * @brief 当前块空间不足：依次尝试后续已有的块，都放不下时申请新块并插到当前块之后
+         */
+        void* allocate_slow(size_t n);
+
+    private:
+        block* m_head = nullptr; ///< 第一个内存块
+        block* m_current = nullptr; ///< 正在切分的内存块
+        char* m_ptr = nullptr; ///< 当前块中下一次分配的位置
+        char* m_end = nullptr; ///< 当前块的结束位置
+        size_t m_next_size; ///< 下一次申请内存块的大小
+        size_t m_capacity = 0; ///< 已申请的内存块总字节数
+    };
+
+    inline void* arena::allocate_slow(const size_t n)
+    {
+        block* b = nullptr == m_current ? m_head : m_current->next;
+        while (nullptr != b && b->size < n)
+            b = b->next; // 放不下的块在本轮 reset() 之前不再使用
+        if (nullptr == b)
+        {
+            const size_t size = n > m_next_size ? round_up(n) : m_next_size;
+            b = static_cast<block*>(malloc_alloc::allocate(BLOCK_HEADER + size));
+            b->size = size;
+            if (nullptr == m_current)
+            {
+                b->next = m_head;
+                m_head = b;
+            }
+            else
+            {
+                b->next = m_current->next;
+                m_current->next = b;
+            }
+            m_capacity += size;
+            if (m_next_size < MAX_BLOCK_SIZE)
+                m_next_size *= 2;
+        }
+        m_current = b;
+        m_ptr = begin(b) + n;
+        m_end = begin(b) + b->size;
+        return begin(b);
+    }
+
+    /**
+     * @brief 内存区分配器：与 default_alloc_template 相同的静态接口，可直接用于 simple_alloc<T, arena_alloc<>>
+     *        以及 vector<T, arena_alloc<>> 等容器
+     *
+     * 分配请求转发给当前线程绑定的内存区（见 scoped_arena），未绑定时使用线程私有的默认内存区。
+     * inst 用于区分互不相干的实例，各实例的绑定关系相互独立。
+     */
+    template <int inst = 0>
+    class arena_alloc
+    {
+    public:
+        static void* allocate(const size_t n)
+        {
+            return current().allocate(n);
+        }
+
+        static void deallocate(void* p, const size_t n)
+        {
+            current().deallocate(p, n);
+        }
+
+        static void* reallocate(void* p, const size_t old_sz, const size_t new_sz)
+        {
+            return current().reallocate(p, old_sz, new_sz);
+        }
+
+        static void* allocate_aligned(const size_t n, const size_t align)
+        {
+            return current().allocate_aligned(n, align);
+        }
+
+        static void deallocate_aligned(void* p, const size_t n, const size_t align)
+        {
+            current().deallocate_aligned(p, n, align);
+        }
+
+        /**
+         * @brief 当前线程使用的内存区
+         */
+        static arena& current()
+        {
+            if (nullptr != bound)
+                return *bound;
+            static thread_local arena local;
+            return local;
+        }
+
+        /**
+         * @brief 将内存区 a 绑定到当前线程，返回之前绑定的内存区（nullptr 表示默认内存区）
+         */
+        static arena* bind(arena* a)
+        {
+            arena* old = bound;
+            bound = a;
+            return old;
+        }
+
+        /**
+         * @brief 回收当前线程内存区中的全部分配，O(1)
+         */
+        static void reset()
+        {
+            current().reset();
+        }
+
+    private:
+        static thread_local arena* bound; ///< 当前线程绑定的内存区
+    };
+
+    template <int inst>
+    thread_local arena* arena_alloc<inst>::bound = nullptr;
+
+    /**
+     * @brief 作用域内存区：构造时把内存区绑定到当前线程，析构时恢复之前的绑定并 reset()
+     *
+     * 用于请求级的内存管理：在作用域内构造的容器全部从该内存区分配，作用域结束时一次性回收。
+     * 可嵌套使用；容器必须在作用域对象之后定义，以保证其析构先于 reset()。
+     */
+    template <typename ArenaAlloc = arena_alloc<>>
+    class scoped_arena
+    {
+    public:
+        /**
+         * @brief 绑定长期存在的内存区，作用域结束后其内存块保留供下一次复用
+         */
+        explicit scoped_arena(arena& a) : m_arena(a), m_prev(ArenaAlloc::bind(&a))
+        {
+        }
+
+        ~scoped_arena()
+        {
+            ArenaAlloc::bind(m_prev);
+            m_arena.reset();
+        }
+
+        scoped_arena(const scoped_arena&) = delete;
+
+        scoped_arena& operator=(const scoped_arena&) = delete;
+
+    private:
+        arena& m_arena; ///< 绑定的内存区
+        arena* m_prev; ///< 之前绑定的内存区
+    };
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef TINY_STL_BACKGROUND_TRIMMER_HPP
+#define TINY_STL_BACKGROUND_TRIMMER_HPP
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "allocator.hpp"
+
+namespace Tiny
+{
+    /**
+     * @brief 后台回收策略：在独立线程中周期性调用 Alloc::trim()，把完全空闲的区块归还系统
+     *
+     * 仅当池中持有的字节数不低于 threshold 时才执行回收，避免在平稳负载下反复申请、归还区块。
+     * Alloc 必须是线程安全的分配器（THREAD_SAFE 为 true，例如 mt_alloc），否则编译失败；对象析构时停止后台线程。
+     */
+    template <typename Alloc>
+    class background_trimmer
+    {
+        static_assert(is_thread_safe_alloc<Alloc>::value,
+                      "background_trimmer calls Alloc::trim() from its own thread; use a thread-safe pool such as mt_alloc");
+
+    public:
+        /**
+         * @brief 构造并启动后台线程
+         * @param interval 两次回收之间的间隔
+         * @param threshold 触发回收所需的最小持有字节数
+         */
+        explicit background_trimmer(const std::chrono::milliseconds interval, const size_t threshold = 0)
+            : m_interval(interval), m_threshold(threshold), m_thread([this] { run(); })
+        {
+        }
+
+        /**
+         * @brief 析构函数，通知后台线程退出并等待其结束
+         */
+        ~background_trimmer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_cv.notify_one();
+            m_thread.join();
+        }
+
+        background_trimmer(const background_trimmer&) = delete;
+
+        background_trimmer& operator=(const background_trimmer&) = delete;
+
+        /**
+         * @brief 后台线程累计归还的字节数
+         */
+        [[nodiscard]] size_t released_bytes() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_released;
+        }
+
+    private:
+        /**
+         * @brief 后台线程主函数
+         */
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_cv.wait_for(lock, m_interval, [this] { return m_stop; }))
+            {
+                lock.unlock();
+                size_t released = 0;
+                if (Alloc::held_bytes() >= m_threshold)
+                    released = Alloc::trim();
+                lock.lock();
+                m_released += released;
+            }
+        }
+
+    private:
+        std::chrono::milliseconds m_interval; ///< 回收间隔
+        size_t m_threshold; ///< 触发回收的持有字节数下限
+        size_t m_released = 0; ///< 累计归还的字节数
+        bool m_stop = false; ///< 停止标志
+        mutable std::mutex m_mutex; ///< 保护停止标志与统计
+        std::condition_variable m_cv; ///< 用于唤醒后台线程
+        std::thread m_thread; ///< 后台线程，最后初始化
+    };
+}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef TINY_STL_CHUNK_SOURCE_HPP
+#define TINY_STL_CHUNK_SOURCE_HPP
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define TINY_STL_HAS_MMAP 1
+#else
+#define TINY_STL_HAS_MMAP 0
+#endif
+
+namespace Tiny
+{
+    /**
+     * @brief 区块来源：记录在区块头中，归还区块时据此选择释放方式
+     */
+    enum class chunk_origin : unsigned char
+    {
+        malloc, ///< malloc 申请
+        mmap, ///< mmap 映射的普通页
+        huge_page ///< mmap 映射并按 2 MiB 对齐、已通过 MADV_HUGEPAGE 请求透明大页
+    };
+
+    /**
+     * @brief 区块来源策略需提供的接口：
+     *        static void* allocate(size_t& bytes, chunk_origin& origin) 申请至少 bytes 字节，
+     *        可以把 bytes 增大到实际可用的大小，失败时返回 nullptr；
+     *        归还默认由 release_chunk 按来源完成，来源也可提供
+     *        static void release(void* p, size_t bytes, chunk_origin origin) 在归还前后做额外处理
+     */
+
+    /**
+     * @brief 按来源归还区块
+     */
+    inline void release_chunk(void* p, const size_t bytes, const chunk_origin origin)
+    {
+#if TINY_STL_HAS_MMAP
+        if (chunk_origin::malloc != origin)
+        {
+            munmap(p, bytes);
+            return;
+        }
+#else
+        (void)bytes;
+        (void)origin;
+#endif
+        free(p);
+    }
+
+    /**
+     * @brief 判断区块来源是否提供 release
+     */
+    template <typename Source, typename = void>
+    struct has_chunk_release : std::false_type
+    {
+    };
+
+    template <typename Source>
+    struct has_chunk_release<Source, std::void_t<decltype(Source::release(nullptr, size_t(), chunk_origin::malloc))>>
+        : std::true_type
+    {
+    };
+
+    /**
+     * @brief 默认来源：直接使用 malloc
+     */
+    struct malloc_chunk_source
+    {
+        static void* allocate(size_t& bytes, chunk_origin& origin)
+        {
+            origin = chunk_origin::malloc;
+            return malloc(bytes);
+        }
+    };
+
+    /**
+     * @brief mmap 来源：按页大小取整后映射匿名内存，不支持 mmap 的平台退回 malloc
+     */
+    struct mmap_chunk_source
+    {
+        static void* allocate(size_t& bytes, chunk_origin& origin)
+        {
+#if TINY_STL_HAS_MMAP
+            static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            const size_t size = (bytes + page - 1) & ~(page - 1);
+            void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (MAP_FAILED != p)
+            {
+                bytes = size;
+                origin = chunk_origin::mmap;
+                return p;
+            }
+#endif
+            return malloc_chunk_source::allocate(bytes, origin);
+        }
+    };
+
+    /**
+     * @brief 大页来源：映射 2 MiB 对齐、大小为 2 MiB 整数倍的区域并请求透明大页，
+     *        遍历大量池化节点时可显著减少 TLB 未命中
+     *
+     * 依次退化：映射失败时改用 mmap_chunk_source（其内部再退回 malloc）；
+     * madvise 不可用或被拒绝时保留普通页映射，来源记为 mmap。
+     */
+    struct huge_page_chunk_source
+    {
+        static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024; ///< x86-64 / AArch64 的透明大页大小
+
+        static void* allocate(size_t& bytes, chunk_origin& origin)
+        {
+#if TINY_STL_HAS_MMAP
+            const size_t size = (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+            // 多映射一个大页，再裁掉首尾未对齐的部分
+            const size_t span = size + HUGE_PAGE_SIZE;
+            void* raw = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (MAP_FAILED != raw)
+            {
+                char* begin = static_cast<char*>(raw);
+                char* aligned = reinterpret_cast<char*>(
+                    (reinterpret_cast<uintptr_t>(begin) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1));
+                if (aligned != begin)
+                    munmap(begin, aligned - begin);
+                if (const size_t tail = begin + span - (aligned + size); tail > 0)
+                    munmap(aligned + size, tail);
+                bytes = size;
+                origin = chunk_origin::mmap;
+#if defined(MADV_HUGEPAGE)
+                if (0 == madvise(aligned, size, MADV_HUGEPAGE))
+                    origin = chunk_origin::huge_page;
+#endif
+                return aligned;
+            }
+#endif
+            return mmap_chunk_source::allocate(bytes, origin);
+        }
+    };
+}
+
+#endif
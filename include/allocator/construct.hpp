@@ -1,17 +1,18 @@
 #ifndef TINY_STL_CONSTRUCT_HPP
 #define TINY_STL_CONSTRUCT_HPP
 #include <new>
+#include <utility>
 #include "iterator/iterator.hpp"
 
 namespace Tiny
 {
     /**
-     * @brief 在给定的地址上构造类型 T1 的对象，使用传入的 value 初始化
+     * @brief 在给定的地址上构造类型 T1 的对象，参数原样转发给构造函数（右值实参触发移动构造）
      */
-    template <typename T1, typename T2>
-    void construct(T1* p, const T2& value)
+    template <typename T1, typename... Args>
+    void construct(T1* p, Args&&... args)
     {
-        new(p) T1(value); // 使用 placement new 进行对象构造
+        new(p) T1(std::forward<Args>(args)...); // 使用 placement new 进行对象构造
     }
 
     /**
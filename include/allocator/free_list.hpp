@@ -0,0 +1,310 @@
+#ifndef TINY_STL_FREE_LIST_HPP
+#define TINY_STL_FREE_LIST_HPP
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+///< ThreadSanitizer 构建下为 1，无锁弹出对过期节点的推测读取需要告知 TSan 忽略
+#if defined(__SANITIZE_THREAD__)
+#define TINY_STL_TSAN 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define TINY_STL_TSAN 1
+#endif
+#endif
+#ifndef TINY_STL_TSAN
+#define TINY_STL_TSAN 0
+#endif
+
+#if TINY_STL_TSAN
+extern "C" void AnnotateIgnoreReadsBegin(const char* file, int line);
+extern "C" void AnnotateIgnoreReadsEnd(const char* file, int line);
+#endif
+
+namespace Tiny
+{
+    /**
+     * @brief 以宽松原子操作读写的链接字，供 lock_free_free_list 的节点用作 free_list_link
+     *
+     * 无锁弹出可能读到已被其他线程取走、正在改写的节点的链接字；宽松原子访问与普通读写生成相同的指令，
+     * 但让这一竞争成为定义良好的行为。
+     */
+    template <typename Node>
+    class relaxed_link
+    {
+    public:
+        relaxed_link() = default;
+        relaxed_link(const relaxed_link&) = default;
+
+        relaxed_link& operator=(Node* p)
+        {
+            __atomic_store_n(&m_ptr, p, __ATOMIC_RELAXED);
+            return *this;
+        }
+
+        relaxed_link& operator=(const relaxed_link& other)
+        {
+            return *this = static_cast<Node*>(other);
+        }
+
+        operator Node*() const // NOLINT 与普通指针字段用法相同
+        {
+            return __atomic_load_n(&m_ptr, __ATOMIC_RELAXED);
+        }
+
+        /**
+         * @brief 无锁弹出时读取可能已失效的链接，与普通读取相同
+         */
+        [[nodiscard]] Node* load_unchecked() const
+        {
+            return *this;
+        }
+
+        /**
+         * @brief 弹出成功后校验读出的链接，普通链接无需校验
+         */
+        void check(Node*) const
+        {
+        }
+
+    private:
+        Node* m_ptr; ///< 下一个节点
+    };
+
+    /**
+     * @brief 无锁中心自由链表（Treiber 栈），节点通过 free_list_link 串联
+     *
+     * 栈顶保存为带版本号的指针：低位存放节点地址，高位存放每次修改递增的版本号，
+     * 使得“弹出 A、弹出 B、压回 A”之后旧的 CAS 因版本号不同而失败，从而规避 ABA 问题。
+     * 弹出时读取的栈顶节点可能已被其他线程取走并改写，因此链接字一律以宽松原子方式读写，
+     * 读出的值只在 CAS 成功后才被使用（加固模式下也只在此时校验）。
+     * 读取过期节点本身仍要求其内存未被归还系统：default_alloc_template::trim() 释放区块前
+     * 通过读者纪元等待所有进行中的弹出结束，object_pool 从不归还区块。
+     */
+    template <typename Node>
+    class lock_free_free_list
+    {
+    private:
+        static_assert(sizeof(void*) <= sizeof(uint64_t), "pointer must fit in 64 bits");
+
+        ///< 地址占用的位数：64 位平台用户态地址不超过 48 位，其余位留给版本号
+        static constexpr unsigned PTR_BITS = sizeof(void*) == 8 ? 48 : 32;
+        static constexpr uint64_t PTR_MASK = (static_cast<uint64_t>(1) << PTR_BITS) - 1;
+
+        static Node* unpack(const uint64_t v)
+        {
+            return reinterpret_cast<Node*>(static_cast<uintptr_t>(v & PTR_MASK));
+        }
+
+        static uint64_t pack(Node* p, const uint64_t old)
+        {
+            const uint64_t tag = (old >> PTR_BITS) + 1;
+            return (tag << PTR_BITS) | (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p)) & PTR_MASK);
+        }
+
+        /**
+         * @brief 链接字访问：普通指针字段以宽松原子方式读写，链接类型（relaxed_link、encoded_link）自带原子访问
+         */
+        static Node* load_link(Node* const& link)
+        {
+            return __atomic_load_n(&link, __ATOMIC_RELAXED);
+        }
+
+        template <typename Link>
+        static Node* load_link(const Link& link)
+        {
+            return link.load_unchecked();
+        }
+
+        static void store_link(Node*& link, Node* p)
+        {
+            __atomic_store_n(&link, p, __ATOMIC_RELAXED);
+        }
+
+        template <typename Link>
+        static void store_link(Link& link, Node* p)
+        {
+            link = p;
+        }
+
+        /**
+         * @brief 推测读取可能已被他人取走的节点 p 的链接
+         *
+         * 链接字之间的竞争已由原子访问消除，但新的持有者随后会以普通写入在同一位置构造对象；
+         * 读到的值在 CAS 失败后即被丢弃，TSan 构建下忽略这一次读取。
+         */
+        static Node* speculative_next(Node* p)
+        {
+#if TINY_STL_TSAN
+            AnnotateIgnoreReadsBegin(__FILE__, __LINE__);
+#endif
+            Node* next = load_link(p->free_list_link);
+#if TINY_STL_TSAN
+            AnnotateIgnoreReadsEnd(__FILE__, __LINE__);
+#endif
+            return next;
+        }
+
+        static void check_link(Node* const&, Node*)
+        {
+        }
+
+        template <typename Link>
+        static void check_link(const Link& link, Node* p)
+        {
+            link.check(p);
+        }
+
+    public:
+        /**
+         * @brief 将已串好的链 [first, last] 整段压入栈顶
+         */
+        void push(Node* first, Node* last)
+        {
+            uint64_t old = m_head.load(std::memory_order_relaxed);
+            do
+            {
+                store_link(last->free_list_link, unpack(old));
+            }
+            while (!m_head.compare_exchange_weak(old, pack(first, old),
+                                                 std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        /**
+         * @brief 弹出单个节点，栈空时返回 nullptr
+         */
+        Node* pop()
+        {
+            uint64_t old = m_head.load(std::memory_order_acquire);
+            for (;;)
+            {
+                Node* p = unpack(old);
+                if (nullptr == p)
+                    return nullptr;
+                // 若 p 已被他人弹出，读到的可能是正在改写的内容，版本号变化会使下面的 CAS 失败
+                Node* next = speculative_next(p);
+                if (m_head.compare_exchange_weak(old, pack(next, old),
+                                                 std::memory_order_acquire, std::memory_order_acquire))
+                {
+                    check_link(p->free_list_link, next);
+                    return p;
+                }
+            }
+        }
+
+        /**
+         * @brief 弹出至多 max 个节点，串成以 nullptr 结尾的链返回，count 为实际数量
+         */
+        Node* pop(const size_t max, size_t& count)
+        {
+            Node* chain = nullptr;
+            for (count = 0; count < max; ++count)
+            {
+                Node* p = pop();
+                if (nullptr == p)
+                    break;
+                store_link(p->free_list_link, chain);
+                chain = p;
+            }
+            return chain;
+        }
+
+        /**
+         * @brief 一次性摘下整条链，返回链表头
+         */
+        Node* pop_all()
+        {
+            uint64_t old = m_head.load(std::memory_order_relaxed);
+            while (!m_head.compare_exchange_weak(old, pack(nullptr, old),
+                                                 std::memory_order_acquire, std::memory_order_relaxed))
+            {
+            }
+            return unpack(old);
+        }
+
+        /**
+         * @brief 判断链表是否为空（仅为瞬时快照）
+         */
+        [[nodiscard]] bool empty() const
+        {
+            return nullptr == unpack(m_head.load(std::memory_order_acquire));
+        }
+
+    private:
+        alignas(64) std::atomic<uint64_t> m_head{0}; ///< 带版本号的栈顶，独占缓存行避免伪共享
+    };
+
+    /**
+     * @brief 互斥锁保护的中心自由链表，接口与 lock_free_free_list 相同，用于对比测试
+     */
+    template <typename Node>
+    class locked_free_list
+    {
+    public:
+        /**
+         * @brief 将已串好的链 [first, last] 整段压入栈顶
+         */
+        void push(Node* first, Node* last)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            last->free_list_link = m_head;
+            m_head = first;
+        }
+
+        /**
+         * @brief 弹出单个节点，栈空时返回 nullptr
+         */
+        Node* pop()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Node* p = m_head;
+            if (nullptr != p)
+                m_head = p->free_list_link;
+            return p;
+        }
+
+        /**
+         * @brief 弹出至多 max 个节点，串成以 nullptr 结尾的链返回，count 为实际数量
+         */
+        Node* pop(const size_t max, size_t& count)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Node* head = m_head;
+            Node* tail = head;
+            count = 0;
+            if (nullptr == head)
+                return nullptr;
+            for (count = 1; count < max && nullptr != tail->free_list_link; ++count)
+                tail = tail->free_list_link;
+            m_head = tail->free_list_link;
+            tail->free_list_link = nullptr;
+            return head;
+        }
+
+        /**
+         * @brief 一次性摘下整条链，返回链表头
+         */
+        Node* pop_all()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Node* head = m_head;
+            m_head = nullptr;
+            return head;
+        }
+
+        /**
+         * @brief 判断链表是否为空
+         */
+        [[nodiscard]] bool empty() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return nullptr == m_head;
+        }
+
+    private:
+        mutable std::mutex m_mutex; ///< 保护链表头
+        Node* m_head = nullptr; ///< 链表头
+    };
+}
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef TINY_STL_HARDENING_HPP
+#define TINY_STL_HARDENING_HPP
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+///< 是否编译二级配置器的加固模式：块前后的金丝雀、释放后填充、重复释放与大小不符检测、自由链表指针编码。
+///< 定义为 0（默认）时全部检查在编译期移除，块布局与未加固时完全相同
+#ifndef TINY_STL_ALLOC_HARDENED
+#define TINY_STL_ALLOC_HARDENED 0
+#endif
+
+namespace Tiny
+{
+    constexpr bool alloc_hardened_enabled = TINY_STL_ALLOC_HARDENED != 0; ///< 加固开关
+
+    /**
+     * @brief 检测到堆损坏时调用：打印诊断信息后终止进程
+     *
+     * 损坏之后继续运行只会让崩溃离错误更远，因此与 glibc 的 "double free detected" 一样直接 abort。
+     */
+    [[noreturn]] inline void alloc_corruption(const char* what, const void* p, const size_t expected = 0,
+                                              const size_t actual = 0)
+    {
+        if (0 != expected || 0 != actual)
+            std::fprintf(stderr, "Tiny allocator: %s at %p (allocated %zu bytes, freed as %zu)\n", what, p, expected,
+                         actual);
+        else
+            std::fprintf(stderr, "Tiny allocator: %s at %p\n", what, p);
+        std::abort();
+    }
+
+    /**
+     * @brief 进程级随机密钥，用于编码自由链表指针与块头，攻击者或野指针无法构造出合法的值
+     */
+    inline uintptr_t alloc_secret()
+    {
+        static const uintptr_t secret = []
+        {
+            uintptr_t s = static_cast<uintptr_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+            s ^= reinterpret_cast<uintptr_t>(&s) * 0x9e3779b97f4a7c15ULL;
+            return s | 1;
+        }();
+        return secret;
+    }
+
+    /**
+     * @brief 编码保存的自由链表指针（仿 glibc safe-linking）：存储值为 ptr ^ (链接字段地址 >> 12) ^ 密钥
+     *
+     * 读出时校验解码后的地址按 ALIGN 对齐，越界写入覆盖链接字段会在下一次分配时被发现，
+     * 而不是把任意地址当作空闲块交给调用者。与 relaxed_link 一样以宽松原子方式读写，
+     * 无锁弹出用 load_unchecked() 读取可能已失效的链接，CAS 成功后才 check()。
+     */
+    template <typename Node, size_t ALIGN>
+    class encoded_link
+    {
+    public:
+        encoded_link& operator=(Node* p)
+        {
+            __atomic_store_n(&m_bits, reinterpret_cast<uintptr_t>(p) ^ key(), __ATOMIC_RELAXED);
+            return *this;
+        }
+
+        encoded_link& operator=(std::nullptr_t)
+        {
+            return *this = static_cast<Node*>(nullptr);
+        }
+
+        operator Node*() const // NOLINT 与普通指针字段用法相同
+        {
+            Node* p = load_unchecked();
+            check(p);
+            return p;
+        }
+
+        /**
+         * @brief 解码链接但不校验：被其他线程取走的块中此处可能已是用户数据
+         */
+        [[nodiscard]] Node* load_unchecked() const
+        {
+            return reinterpret_cast<Node*>(__atomic_load_n(&m_bits, __ATOMIC_RELAXED) ^ key());
+        }
+
+        /**
+         * @brief 校验解码后的地址按 ALIGN 对齐，否则报告链接被破坏
+         */
+        void check(Node* p) const
+        {
+            if (0 != reinterpret_cast<uintptr_t>(p) % ALIGN)
+                alloc_corruption("corrupted free-list link", this);
+        }
+
+    private:
+        [[nodiscard]] uintptr_t key() const
+        {
+            return (reinterpret_cast<uintptr_t>(this) >> 12) ^ alloc_secret();
+        }
+
+        uintptr_t m_bits; ///< 编码后的指针
+    };
+
+    /**
+     * @brief 加固模式下的块布局与检查
+     *
+     * [链接字 | 块头 | 用户数据 n 字节 | 尾部金丝雀]，链接字在块空闲时被自由链表占用，用户数据不会被覆盖；
+     * 块头编码了状态魔数与请求大小，尾部金丝雀紧跟用户数据（可能不对齐）。
+     */
+    template <size_t ALIGN>
+    struct block_guard
+    {
+        static constexpr size_t LINK = sizeof(void*); ///< 链接字占用的字节数
+        static constexpr size_t FRONT = LINK + sizeof(uint64_t) > ALIGN ? LINK + sizeof(uint64_t) : ALIGN; ///< 用户数据偏移
+        static constexpr size_t OVERHEAD = FRONT + sizeof(uint64_t); ///< 每块额外占用的字节数
+        static constexpr unsigned char POISON = 0xdd; ///< 释放后填充的字节
+        static constexpr size_t POISON_CHECK_BYTES = 64; ///< 重新分配时校验的填充字节数上限，控制开销
+
+        ///< 块头低 32 位的状态魔数，新切分的块中的随机内容几乎不可能恰好解码成其中之一
+        enum state : uint64_t
+        {
+            ALLOCATED = 0xa110c8edu,
+            FREED = 0xf4eeb10cu
+        };
+
+        static uint64_t* header(char* user)
+        {
+            return reinterpret_cast<uint64_t*>(user - sizeof(uint64_t));
+        }
+
+        static uint64_t key(const char* user)
+        {
+            return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(user)) ^ alloc_secret();
+        }
+
+        static uint64_t encode(const char* user, const size_t n, const state s)
+        {
+            return ((static_cast<uint64_t>(n) << 32) | s) ^ key(user);
+        }
+
+        static uint64_t trailer_value(const char* user)
+        {
+            return ~key(user);
+        }
+
+        /**
+         * @brief 把刚从池中取出的块转为用户指针：块上次释放后的填充被改动时报告释放后写入，
+         *        然后写入块头与尾部金丝雀
+         */
+        static void* on_allocate(void* block, const size_t n)
+        {
+            char* user = static_cast<char*>(block) + FRONT;
+            const uint64_t h = *header(user) ^ key(user);
+            if (FREED == (h & 0xffffffffu))
+            {
+                const size_t freed = std::min<size_t>(h >> 32, POISON_CHECK_BYTES);
+                for (size_t i = 0; i < freed; ++i)
+                {
+                    if (POISON != static_cast<unsigned char>(user[i]))
+                        alloc_corruption("write after free", user);
+                }
+            }
+            *header(user) = encode(user, n, ALLOCATED);
+            const uint64_t trailer = trailer_value(user);
+            std::memcpy(user + n, &trailer, sizeof(trailer));
+            return user;
+        }
+
+        /**
+         * @brief 校验待释放的用户指针并填充，返回池中的块地址
+         */
+        static void* on_deallocate(void* p, const size_t n)
+        {
+            char* user = static_cast<char*>(p);
+            const uint64_t h = *header(user) ^ key(user);
+            const size_t stored = static_cast<size_t>(h >> 32);
+            if (FREED == (h & 0xffffffffu) && stored == n)
+                alloc_corruption("double free", p);
+            if (ALLOCATED != (h & 0xffffffffu))
+                alloc_corruption("free of invalid pointer or corrupted block header", p);
+            if (stored != n)
+                alloc_corruption("free with wrong size", p, stored, n);
+            uint64_t trailer;
+            std::memcpy(&trailer, user + n, sizeof(trailer));
+            if (trailer != trailer_value(user))
+                alloc_corruption("buffer overflow past end of block", p);
+            std::memset(user, POISON, n);
+            *header(user) = encode(user, n, FREED);
+            return user - FRONT;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,457 @@
+#ifndef TINY_STL_HEAP_PROFILER_HPP
+#define TINY_STL_HEAP_PROFILER_HPP
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+///< 是否编译采样堆分析器的钩子，定义为 0 时分配路径上的采样代码在编译期移除。
+///< 编译进来后默认仍处于关闭状态，由 heap_profiler::set_sample_interval 或环境变量 TINY_STL_HEAP_SAMPLE 开启
+#ifndef TINY_STL_HEAP_PROFILER
+#define TINY_STL_HEAP_PROFILER 1
+#endif
+
+#if TINY_STL_HEAP_PROFILER && __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define TINY_STL_HAS_BACKTRACE 1
+#else
+#define TINY_STL_HAS_BACKTRACE 0
+#endif
+
+namespace Tiny
+{
+    constexpr bool heap_profiler_enabled = TINY_STL_HEAP_PROFILER != 0; ///< 采样堆分析器开关
+
+    /**
+     * @brief 采样堆分析器：平均每分配 interval 字节抽取一次，记录调用栈，按调用点汇总仍存活的字节数
+     *
+     * 每个线程维护一个字节倒计时，分配时只做一次减法与比较；倒计时耗尽时才进入慢路径抓取调用栈。
+     * 释放时没有存活的采样则直接返回；否则查一张按地址散列的计数表，只有可能被采样过的地址才加锁查找。
+     * 采样间隔服从指数分布，dump() 输出 gperftools 的 heap_v2 文本格式，pprof 可直接读取并按采样率还原。
+     */
+    class heap_profiler
+    {
+    public:
+        static constexpr size_t MAX_FRAMES = 32; ///< 单个调用栈保留的最大帧数
+        static constexpr size_t DISABLED_RECHECK = 1024 * 1024; ///< 关闭状态下每个线程每分配这么多字节重新检查一次开关
+
+        /**
+         * @brief 单个调用点的汇总
+         */
+        struct site
+        {
+            std::vector<void*> stack; ///< 调用栈，最内层在前
+            size_t live_count = 0; ///< 仍存活的采样次数
+            size_t live_bytes = 0; ///< 仍存活的采样字节数（未按采样率还原）
+            size_t alloc_count = 0; ///< 累计采样次数
+            size_t alloc_bytes = 0; ///< 累计采样字节数
+        };
+
+        /**
+         * @brief 设置平均采样间隔（字节），0 表示关闭
+         *
+         * 调用线程立即生效；其他线程在各自的倒计时耗尽后生效，关闭状态下至多再分配 DISABLED_RECHECK 字节。
+         */
+        static void set_sample_interval(const size_t bytes)
+        {
+            state().interval.store(bytes, std::memory_order_relaxed);
+            bytes_until_sample() = 0;
+        }
+
+        /**
+         * @brief 当前平均采样间隔，0 表示关闭
+         */
+        static size_t sample_interval()
+        {
+            return state().interval.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 分配钩子：p 为返回给调用者的地址，n 为请求字节数
+         */
+        static void on_allocate(void* p, const size_t n)
+        {
+            if constexpr (heap_profiler_enabled)
+            {
+                size_t& countdown = bytes_until_sample();
+                if (countdown > n)
+                {
+                    countdown -= n;
+                    return;
+                }
+                if (nullptr != p)
+                    sample(p, n);
+            }
+        }
+
+        /**
+         * @brief 释放钩子：p 被采样过时从存活集合中移除
+         */
+        static void on_deallocate(void* p)
+        {
+            if constexpr (heap_profiler_enabled)
+            {
+                if (0 != live_samples().load(std::memory_order_relaxed) &&
+                    0 != filter()[filter_slot(p)].load(std::memory_order_relaxed))
+                    forget(p);
+            }
+        }
+
+        /**
+         * @brief realloc 期间从存活集合摘下的采样记录
+         */
+        struct detached
+        {
+            size_t site = SIZE_MAX; ///< 所属调用点下标，SIZE_MAX 表示 p 未被采样
+            size_t bytes = 0; ///< 请求字节数
+        };
+
+        /**
+         * @brief 重新分配前钩子：把 p 的采样记录摘出存活集合，调用点的存活统计暂不变动
+         *
+         * realloc 成功后原指针已失效，不能再按地址查找，因此查找必须在调用 realloc 之前完成。
+         */
+        static detached on_reallocate_begin(void* p)
+        {
+            if constexpr (heap_profiler_enabled)
+            {
+                if (0 != live_samples().load(std::memory_order_relaxed) &&
+                    0 != filter()[filter_slot(p)].load(std::memory_order_relaxed))
+                    return detach(p);
+            }
+            return detached{};
+        }
+
+        /**
+         * @brief 重新分配失败钩子：p 仍然有效，把摘下的记录放回存活集合
+         */
+        static void on_reallocate_failed(void* p, const detached& d)
+        {
+            if constexpr (heap_profiler_enabled)
+            {
+                if (SIZE_MAX != d.site)
+                    reattach(p, d);
+            }
+        }
+
+        /**
+         * @brief 重新分配成功钩子：此时才从调用点统计中扣除旧记录，再按新地址 result 与大小 n 采样
+         */
+        static void on_reallocate_end(const detached& d, void* result, const size_t n)
+        {
+            if constexpr (heap_profiler_enabled)
+            {
+                if (SIZE_MAX != d.site)
+                    release(d);
+            }
+            on_allocate(result, n);
+        }
+
+        /**
+         * @brief 各调用点的汇总快照
+         */
+        static std::vector<site> sites()
+        {
+            profiler_state& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            return s.sites;
+        }
+
+        /**
+         * @brief 所有调用点仍存活的采样字节数之和（未按采样率还原）
+         */
+        static size_t live_sampled_bytes()
+        {
+            size_t bytes = 0;
+            for (const site& s : sites())
+                bytes += s.live_bytes;
+            return bytes;
+        }
+
+        /**
+         * @brief 以 heap_v2 文本格式输出当前画像，末尾附带 /proc/self/maps 供 pprof 符号化
+         * @return 写入成功时返回 true
+         */
+        static bool dump(FILE* out)
+        {
+            profiler_state& s = state();
+            std::vector<site> snapshot;
+            size_t rate;
+            {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                snapshot = s.sites;
+                rate = s.dumped_interval;
+            }
+            site total;
+            for (const site& e : snapshot)
+            {
+                total.live_count += e.live_count;
+                total.live_bytes += e.live_bytes;
+                total.alloc_count += e.alloc_count;
+                total.alloc_bytes += e.alloc_bytes;
+            }
+            std::fprintf(out, "heap profile: %zu: %zu [%zu: %zu] @ heap_v2/%zu\n", total.live_count, total.live_bytes,
+                         total.alloc_count, total.alloc_bytes, std::max<size_t>(rate, 1));
+            for (const site& e : snapshot)
+            {
+                std::fprintf(out, "%zu: %zu [%zu: %zu] @", e.live_count, e.live_bytes, e.alloc_count, e.alloc_bytes);
+                for (void* frame : e.stack)
+                    std::fprintf(out, " %p", frame);
+                std::fputc('\n', out);
+            }
+#if defined(__linux__)
+            std::fputs("\nMAPPED_LIBRARIES:\n", out);
+            if (FILE* maps = std::fopen("/proc/self/maps", "r"))
+            {
+                char buf[4096];
+                size_t len;
+                while (0 != (len = std::fread(buf, 1, sizeof(buf), maps)))
+                    std::fwrite(buf, 1, len, out);
+                std::fclose(maps);
+            }
+#endif
+            return 0 == std::ferror(out);
+        }
+
+        /**
+         * @brief 把画像写入文件 path
+         */
+        static bool dump(const char* path)
+        {
+            FILE* out = std::fopen(path, "w");
+            if (nullptr == out)
+                return false;
+            const bool ok = dump(out);
+            return 0 == std::fclose(out) && ok;
+        }
+
+        /**
+         * @brief 清空全部采样记录，已采样但尚未释放的地址不再跟踪
+         */
+        static void reset()
+        {
+            profiler_state& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.sites.clear();
+            s.site_index.clear();
+            s.live.clear();
+            for (size_t i = 0; i < FILTER_SIZE; ++i)
+                filter()[i].store(0, std::memory_order_relaxed);
+            live_samples().store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t FILTER_BITS = 12; ///< 释放过滤表的下标位数
+        static constexpr size_t FILTER_SIZE = size_t{1} << FILTER_BITS; ///< 释放过滤表的槽数
+
+        /**
+         * @brief 被采样的存活块
+         */
+        struct sample_record
+        {
+            size_t site; ///< 所属调用点在 sites 中的下标
+            size_t bytes; ///< 请求字节数
+        };
+
+        /**
+         * @brief 按调用栈散列
+         */
+        struct stack_hash
+        {
+            size_t operator()(const std::vector<void*>& stack) const
+            {
+                size_t h = stack.size();
+                for (void* frame : stack)
+                    h = (h ^ reinterpret_cast<uintptr_t>(frame)) * 0x100000001b3ULL;
+                return h;
+            }
+        };
+
+        struct profiler_state
+        {
+            std::atomic<size_t> interval{0}; ///< 平均采样间隔，0 表示关闭
+            size_t dumped_interval = 0; ///< 最近一次采样时使用的间隔，写入画像头部
+            std::mutex mutex; ///< 保护以下容器
+            std::vector<site> sites; ///< 全部调用点
+            std::unordered_map<std::vector<void*>, size_t, stack_hash> site_index; ///< 调用栈到调用点下标
+            std::unordered_map<void*, sample_record> live; ///< 存活的采样块
+
+            profiler_state()
+            {
+                if (const char* env = std::getenv("TINY_STL_HEAP_SAMPLE"))
+                    interval.store(std::strtoull(env, nullptr, 10), std::memory_order_relaxed);
+            }
+        };
+
+        /**
+         * @brief 全局状态，首次使用时构造且永不析构，进程退出阶段的释放仍可安全调用钩子
+         */
+        static profiler_state& state()
+        {
+            static profiler_state* s = new profiler_state;
+            return *s;
+        }
+
+        /**
+         * @brief 释放过滤表：各散列槽中存活的采样数，常量初始化，释放路径上无需检查构造守卫
+         */
+        static std::atomic<uint32_t>* filter()
+        {
+            static std::atomic<uint32_t> slots[FILTER_SIZE];
+            return slots;
+        }
+
+        /**
+         * @brief 存活的采样块总数，为 0 时释放路径跳过过滤表，只读取这一个几乎不被修改的缓存行
+         */
+        static std::atomic<size_t>& live_samples()
+        {
+            static std::atomic<size_t> count{0};
+            return count;
+        }
+
+        /**
+         * @brief 当前线程距离下一次采样剩余的字节数，初始为 0 使线程的第一次分配读取开关
+         */
+        static size_t& bytes_until_sample()
+        {
+            static thread_local size_t countdown = 0;
+            return countdown;
+        }
+
+        static size_t filter_slot(const void* p)
+        {
+            return static_cast<size_t>(reinterpret_cast<uintptr_t>(p) * 0x9e3779b97f4a7c15ULL >> (64 - FILTER_BITS));
+        }
+
+        /**
+         * @brief 按指数分布抽取下一次采样前的字节数，均值为 interval
+         */
+        static size_t next_interval(const size_t interval)
+        {
+            static thread_local uint64_t rng = reinterpret_cast<uintptr_t>(&rng) | 1;
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            const double u = (static_cast<double>(rng >> 11) + 1.0) / 9007199254740993.0; // (0, 1]
+            return static_cast<size_t>(-std::log(u) * static_cast<double>(interval)) + 1;
+        }
+
+        /**
+         * @brief 慢路径：倒计时耗尽，重新抽取间隔；开启时记录本次分配
+         */
+        __attribute__((noinline)) static void sample(void* p, const size_t n)
+        {
+            profiler_state& s = state();
+            const size_t interval = s.interval.load(std::memory_order_relaxed);
+            if (0 == interval)
+            {
+                bytes_until_sample() = DISABLED_RECHECK;
+                return;
+            }
+            bytes_until_sample() = next_interval(interval);
+
+            std::vector<void*> stack(MAX_FRAMES + 1);
+#if TINY_STL_HAS_BACKTRACE
+            const int depth = backtrace(stack.data(), static_cast<int>(stack.size()));
+            stack.erase(stack.begin()); // 去掉 sample 自身
+            stack.resize(depth > 1 ? depth - 1 : 0);
+#else
+            stack.resize(1);
+            stack[0] = __builtin_return_address(0);
+#endif
+
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.dumped_interval = interval;
+            auto [it, inserted] = s.site_index.try_emplace(std::move(stack), s.sites.size());
+            if (inserted)
+                s.sites.push_back(site{it->first});
+            site& e = s.sites[it->second];
+            ++e.live_count;
+            e.live_bytes += n;
+            ++e.alloc_count;
+            e.alloc_bytes += n;
+            // 同一地址被重复记录说明上次的释放未经过钩子，以新记录为准
+            if (auto [old, fresh] = s.live.try_emplace(p, sample_record{it->second, n}); !fresh)
+            {
+                site& stale = s.sites[old->second.site];
+                --stale.live_count;
+                stale.live_bytes -= old->second.bytes;
+                old->second = sample_record{it->second, n};
+                return;
+            }
+            filter()[filter_slot(p)].fetch_add(1, std::memory_order_relaxed);
+            live_samples().fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 慢路径：过滤表命中，查找并移除采样记录
+         */
+        __attribute__((noinline)) static void forget(void* p)
+        {
+            profiler_state& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            const auto it = s.live.find(p);
+            if (s.live.end() == it)
+                return;
+            site& e = s.sites[it->second.site];
+            --e.live_count;
+            e.live_bytes -= it->second.bytes;
+            s.live.erase(it);
+            filter()[filter_slot(p)].fetch_sub(1, std::memory_order_relaxed);
+            live_samples().fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 慢路径：摘下 p 的采样记录，保留调用点统计
+         */
+        __attribute__((noinline)) static detached detach(void* p)
+        {
+            profiler_state& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            const auto it = s.live.find(p);
+            if (s.live.end() == it)
+                return detached{};
+            const detached d{it->second.site, it->second.bytes};
+            s.live.erase(it);
+            filter()[filter_slot(p)].fetch_sub(1, std::memory_order_relaxed);
+            live_samples().fetch_sub(1, std::memory_order_relaxed);
+            return d;
+        }
+
+        /**
+         * @brief 慢路径：把摘下的记录放回存活集合；期间若被 reset 则丢弃
+         */
+        __attribute__((noinline)) static void reattach(void* p, const detached& d)
+        {
+            profiler_state& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            if (d.site >= s.sites.size() || !s.live.try_emplace(p, sample_record{d.site, d.bytes}).second)
+                return;
+            filter()[filter_slot(p)].fetch_add(1, std::memory_order_relaxed);
+            live_samples().fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 慢路径：从调用点的存活统计中扣除摘下的记录；期间若被 reset 则忽略
+         */
+        __attribute__((noinline)) static void release(const detached& d)
+        {
+            profiler_state& s = state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            if (d.site >= s.sites.size())
+                return;
+            site& e = s.sites[d.site];
+            --e.live_count;
+            e.live_bytes -= d.bytes;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef TINY_STL_MEMORY_RESOURCE_HPP
+#define TINY_STL_MEMORY_RESOURCE_HPP
+#include <cstddef>
+#include <cstring>
+
+#include "allocator.hpp"
+#include "arena.hpp"
+
+namespace Tiny
+{
+    /**
+     * @brief 内存资源抽象基类（仿 std::pmr::memory_resource），由 polymorphic_alloc 在运行时选择具体实现
+     */
+    class memory_resource
+    {
+    public:
+        virtual ~memory_resource() = default;
+
+        void* allocate(const size_t n)
+        {
+            return do_allocate(n);
+        }
+
+        void deallocate(void* p, const size_t n)
+        {
+            do_deallocate(p, n);
+        }
+
+        void* reallocate(void* p, const size_t old_sz, const size_t new_sz)
+        {
+            return do_reallocate(p, old_sz, new_sz);
+        }
+
+        void* allocate_aligned(const size_t n, const size_t align)
+        {
+            return do_allocate_aligned(n, align);
+        }
+
+        void deallocate_aligned(void* p, const size_t n, const size_t align)
+        {
+            do_deallocate_aligned(p, n, align);
+        }
+
+        /**
+         * @brief 判断两个资源能否互相释放对方分配的内存
+         */
+        [[nodiscard]] bool is_equal(const memory_resource& other) const
+        {
+            return this == &other || do_is_equal(other);
+        }
+
+    protected:
+        virtual void* do_allocate(size_t n) = 0;
+
+        virtual void do_deallocate(void* p, size_t n) = 0;
+
+        /**
+         * @brief 默认实现：分配新内存、拷贝、释放旧内存
+         */
+        virtual void* do_reallocate(void* p, const size_t old_sz, const size_t new_sz)
+        {
+            void* result = do_allocate(new_sz);
+            std::memcpy(result, p, old_sz < new_sz ? old_sz : new_sz);
+            do_deallocate(p, old_sz);
+            return result;
+        }
+
+        /**
+         * @brief 默认实现：多分配 align 字节并在其中对齐，偏移量记录在返回地址之前
+         */
+        virtual void* do_allocate_aligned(const size_t n, const size_t align)
+        {
+            return align_and_record(do_allocate(n + align), align);
+        }
+
+        virtual void do_deallocate_aligned(void* p, const size_t n, const size_t align)
+        {
+            do_deallocate(aligned_origin(p), n + align);
+        }
+
+        [[nodiscard]] virtual bool do_is_equal(const memory_resource& other) const
+        {
+            return this == &other;
+        }
+    };
+
+    /**
+     * @brief 将静态分配策略（alloc、mt_alloc 等）包装成内存资源
+     */
+    template <typename Alloc>
+    class policy_resource final : public memory_resource
+    {
+    protected:
+        void* do_allocate(const size_t n) override
+        {
+            return Alloc::allocate(n);
+        }
+
+        void do_deallocate(void* p, const size_t n) override
+        {
+            Alloc::deallocate(p, n);
+        }
+
+        void* do_reallocate(void* p, const size_t old_sz, const size_t new_sz) override
+        {
+            return Alloc::reallocate(p, old_sz, new_sz);
+        }
+
+        void* do_allocate_aligned(const size_t n, const size_t align) override
+        {
+            return Alloc::allocate_aligned(n, align);
+        }
+
+        void do_deallocate_aligned(void* p, const size_t n, const size_t align) override
+        {
+            Alloc::deallocate_aligned(p, n, align);
+        }
+
+        [[nodiscard]] bool do_is_equal(const memory_resource& other) const override
+        {
+            return nullptr != dynamic_cast<const policy_resource*>(&other); // 同一策略的实例共享同一个池
+        }
+    };
+
+    /**
+     * @brief 单调内存资源：内部持有一个 arena，释放为空操作，release() 一次性回收全部内存
+     *
+     * 适合为每个连接或会话单独创建，连接结束时整体释放。
+     */
+    class monotonic_resource final : public memory_resource
+    {
+    public:
+        explicit monotonic_resource(const size_t block_size = arena::DEFAULT_BLOCK_SIZE) : m_arena(block_size)
+        {
+        }
+
+        /**
+         * @brief 回收全部分配，保留内存块供复用，O(1)
+         */
+        void reset()
+        {
+            m_arena.reset();
+        }
+
+        /**
+         * @brief 回收全部分配并把内存块归还系统
+         */
+        void release()
+        {
+            m_arena.release();
+        }
+
+        /**
+         * @brief 已申请的内存块总字节数
+         */
+        [[nodiscard]] size_t capacity() const
+        {
+            return m_arena.capacity();
+        }
+
+    protected:
+        void* do_allocate(const size_t n) override
+        {
+            return m_arena.allocate(n);
+        }
+
+        void do_deallocate(void* p, const size_t n) override
+        {
+            m_arena.deallocate(p, n);
+        }
+
+        void* do_reallocate(void* p, const size_t old_sz, const size_t new_sz) override
+        {
+            return m_arena.reallocate(p, old_sz, new_sz);
+        }
+
+        void* do_allocate_aligned(const size_t n, const size_t align) override
+        {
+            return m_arena.allocate_aligned(n, align);
+        }
+
+        void do_deallocate_aligned(void* p, const size_t n, const size_t align) override
+        {
+            m_arena.deallocate_aligned(p, n, align);
+        }
+
+    private:
+        arena m_arena; ///< 底层内存区
+    };
+
+    /**
+     * @brief 默认内存资源：二级配置器 alloc
+     */
+    inline memory_resource* default_resource()
+    {
+        static policy_resource<alloc> resource;
+        return &resource;
+    }
+
+    /**
+     * @brief 多态分配器：持有指向内存资源的指针，不同容器可以使用不同的资源
+     *
+     * 接口与静态分配策略相同（allocate/deallocate/reallocate），但为成员函数，容器通过 alloc_base 保存其实例。
+     */
+    class polymorphic_alloc
+    {
+    public:
+        static constexpr size_t ALIGN = default_size_classes::ALIGN; ///< 各内存资源至少保证的对齐
+
+        polymorphic_alloc() : m_resource(default_resource())
+        {
+        }
+
+        polymorphic_alloc(memory_resource* r) : m_resource(r) // NOLINT 允许由资源指针隐式构造
+        {
+        }
+
+        void* allocate(const size_t n) const
+        {
+            return m_resource->allocate(n);
+        }
+
+        void deallocate(void* p, const size_t n) const
+        {
+            m_resource->deallocate(p, n);
+        }
+
+        void* reallocate(void* p, const size_t old_sz, const size_t new_sz) const
+        {
+            return m_resource->reallocate(p, old_sz, new_sz);
+        }
+
+        void* allocate_aligned(const size_t n, const size_t align) const
+        {
+            return m_resource->allocate_aligned(n, align);
+        }
+
+        void deallocate_aligned(void* p, const size_t n, const size_t align) const
+        {
+            m_resource->deallocate_aligned(p, n, align);
+        }
+
+        [[nodiscard]] memory_resource* resource() const
+        {
+            return m_resource;
+        }
+
+        bool operator==(const polymorphic_alloc& other) const
+        {
+            return m_resource->is_equal(*other.m_resource);
+        }
+
+        bool operator!=(const polymorphic_alloc& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        memory_resource* m_resource; ///< 内存资源，不拥有其所有权
+    };
+}
+
+#endif
@@ -0,0 +1,463 @@
+#ifndef TINY_STL_NUMA_HPP
+#define TINY_STL_NUMA_HPP
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "allocator.hpp"
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if __has_include(<linux/mempolicy.h>)
+#include <linux/mempolicy.h>
+#endif
+#endif
+
+namespace Tiny
+{
+    /**
+     * @brief NUMA 拓扑：启动后首次使用时从 /sys/devices/system/node 读取各节点的 CPU 列表
+     *
+     * 非 Linux 平台或读取失败时视为只有一个节点，所有 CPU 都属于节点 0。
+     */
+    class numa_topology
+    {
+    public:
+        /**
+         * @brief 节点数量，至少为 1
+         */
+        static unsigned node_count()
+        {
+            return static_cast<unsigned>(instance().m_node_cpus.size());
+        }
+
+        /**
+         * @brief CPU 所属的节点，未知的 CPU 归入节点 0
+         */
+        static unsigned node_of_cpu(const unsigned cpu)
+        {
+            const auto& map = instance().m_cpu_node;
+            return cpu < map.size() ? map[cpu] : 0;
+        }
+
+        /**
+         * @brief 节点包含的 CPU 列表
+         */
+        static const std::vector<unsigned>& cpus_of_node(const unsigned node)
+        {
+            return instance().m_node_cpus[node < node_count() ? node : 0];
+        }
+
+    private:
+        numa_topology()
+        {
+#if defined(__linux__)
+            for (unsigned node = 0;; ++node)
+            {
+                char path[64];
+                std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%u/cpulist", node);
+                FILE* f = std::fopen(path, "r");
+                if (nullptr == f)
+                    break;
+                std::vector<unsigned> cpus;
+                unsigned first = 0;
+                unsigned last = 0;
+                // 格式形如 "0-3,8-11"
+                while (1 == std::fscanf(f, "%u", &first))
+                {
+                    last = first;
+                    int c = std::fgetc(f);
+                    if ('-' == c)
+                    {
+                        if (1 != std::fscanf(f, "%u", &last))
+                            break;
+                        c = std::fgetc(f);
+                    }
+                    for (unsigned cpu = first; cpu <= last; ++cpu)
+                        cpus.push_back(cpu);
+                    if (',' != c)
+                        break;
+                }
+                std::fclose(f);
+                for (const unsigned cpu : cpus)
+                {
+                    if (cpu >= m_cpu_node.size())
+                        m_cpu_node.resize(cpu + 1, 0);
+                    m_cpu_node[cpu] = node;
+                }
+                m_node_cpus.push_back(std::move(cpus));
+            }
+#endif
+            if (m_node_cpus.empty())
+                m_node_cpus.emplace_back();
+        }
+
+        static const numa_topology& instance()
+        {
+            static const numa_topology topology;
+            return topology;
+        }
+
+    private:
+        std::vector<std::vector<unsigned>> m_node_cpus; ///< 各节点的 CPU 列表
+        std::vector<unsigned> m_cpu_node; ///< CPU 到节点的映射
+    };
+
+    /**
+     * @brief 当前线程绑定的节点，-1 表示未绑定、按所在 CPU 推断
+     */
+    inline int& numa_thread_node()
+    {
+        static thread_local int node = -1;
+        return node;
+    }
+
+    /**
+     * @brief 当前线程所在的节点：已绑定时直接返回，否则按当前 CPU 查询
+     */
+    inline unsigned numa_current_node()
+    {
+        if (const int node = numa_thread_node(); node >= 0)
+            return static_cast<unsigned>(node);
+#if defined(__linux__)
+        if (const int cpu = sched_getcpu(); cpu >= 0)
+            return numa_topology::node_of_cpu(static_cast<unsigned>(cpu));
+#endif
+        return 0;
+    }
+
+    /**
+     * @brief 将 [p, p + bytes) 的物理内存优先放在 node 上（mbind + MPOL_PREFERRED）
+     * @return 内核不支持或调用失败时返回 false，此时内存按首次访问的节点分配
+     */
+    inline bool numa_bind_memory(void* p, const size_t bytes, const unsigned node)
+    {
+#if defined(__linux__) && defined(SYS_mbind) && defined(MPOL_PREFERRED)
+        if (node >= 8 * sizeof(unsigned long))
+            return false;
+        const unsigned long mask = 1UL << node;
+        return 0 == syscall(SYS_mbind, p, bytes, MPOL_PREFERRED, &mask, 8 * sizeof(mask), 0);
+#else
+        (void)p;
+        (void)bytes;
+        (void)node;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 将当前线程固定到 node：CPU 亲和性限定在该节点，默认内存策略改为优先该节点，
+     *        并令 numa_current_node() 直接返回 node
+     * @return CPU 亲和性设置成功时返回 true；内存策略设置失败不影响返回值
+     */
+    inline bool numa_pin_thread(const unsigned node)
+    {
+        numa_thread_node() = static_cast<int>(node);
+#if defined(__linux__)
+        bool pinned = false;
+        if (const auto& cpus = numa_topology::cpus_of_node(node); !cpus.empty())
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (const unsigned cpu : cpus)
+                CPU_SET(cpu, &set);
+            pinned = 0 == sched_setaffinity(0, sizeof(set), &set);
+        }
+#if defined(SYS_set_mempolicy) && defined(MPOL_PREFERRED)
+        if (node < 8 * sizeof(unsigned long))
+        {
+            const unsigned long mask = 1UL << node;
+            syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask, 8 * sizeof(mask));
+        }
+#endif
+        return pinned;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 生成 ThreadPool 的线程初始化回调：各工作线程依次轮流固定到各个节点
+     *
+     * 用法：pool.setThreadInitCallback(numa_worker_init()); pool.start(n);
+     */
+    inline std::function<void()> numa_worker_init()
+    {
+        auto next = std::make_shared<std::atomic<unsigned>>(0);
+        return [next]()
+        {
+            numa_pin_thread(next->fetch_add(1) % numa_topology::node_count());
+        };
+    }
+
+    /**
+     * @brief 页到节点池的映射：numa_chunk_source 映射区块时登记、归还区块时清除，
+     *        numa_alloc 释放内存块时据此找到分配它的池
+     *
+     * 按 4 KiB 页组织成三级基数树（每级 4096 项），覆盖 48 位地址空间；中间层与叶子按需申请、不再释放。
+     * 查询无锁，登记与清除由互斥量串行化。
+     */
+    class numa_page_map
+    {
+    public:
+        /**
+         * @brief 登记按页对齐的区域 [p, p + bytes) 属于第 pool 个池
+         */
+        static void set(const void* p, const size_t bytes, const unsigned pool)
+        {
+            store(p, bytes, static_cast<unsigned char>(pool + 1));
+        }
+
+        /**
+         * @brief 清除 [p, p + bytes) 的登记
+         */
+        static void clear(const void* p, const size_t bytes)
+        {
+            store(p, bytes, 0);
+        }
+
+        /**
+         * @brief 地址所在页登记的池，未登记时返回 -1
+         */
+        static int find(const void* p)
+        {
+            const uintptr_t page = reinterpret_cast<uintptr_t>(p) >> PAGE_SHIFT;
+            if (0 != page >> (3 * LEVEL_BITS))
+                return -1;
+            const middle* m = root()[page >> (2 * LEVEL_BITS)].load(std::memory_order_acquire);
+            if (nullptr == m)
+                return -1;
+            const leaf* l = m->leaves[(page >> LEVEL_BITS) & (LEVEL_SIZE - 1)].load(std::memory_order_acquire);
+            if (nullptr == l)
+                return -1;
+            return static_cast<int>(l->pools[page & (LEVEL_SIZE - 1)].load(std::memory_order_relaxed)) - 1;
+        }
+
+    private:
+        static constexpr unsigned PAGE_SHIFT = 12;
+        static constexpr unsigned LEVEL_BITS = 12;
+        static constexpr size_t LEVEL_SIZE = static_cast<size_t>(1) << LEVEL_BITS;
+
+        struct leaf
+        {
+            std::atomic<unsigned char> pools[LEVEL_SIZE]; ///< 各页所属的池加 1，0 表示未登记
+        };
+
+        struct middle
+        {
+            std::atomic<leaf*> leaves[LEVEL_SIZE];
+        };
+
+        static std::atomic<middle*>* root()
+        {
+            static std::atomic<middle*> nodes[LEVEL_SIZE];
+            return nodes;
+        }
+
+        /**
+         * @brief 逐页写入 value；申请中间层或叶子失败时放弃登记，这些页的释放退回按本地节点选择
+         */
+        static void store(const void* p, const size_t bytes, const unsigned char value)
+        {
+            static std::mutex mutex;
+            std::lock_guard<std::mutex> lock(mutex);
+            const uintptr_t first = reinterpret_cast<uintptr_t>(p) >> PAGE_SHIFT;
+            const uintptr_t last = (reinterpret_cast<uintptr_t>(p) + bytes - 1) >> PAGE_SHIFT;
+            if (0 == bytes || 0 != last >> (3 * LEVEL_BITS))
+                return;
+            for (uintptr_t page = first; page <= last; ++page)
+            {
+                std::atomic<middle*>& slot = root()[page >> (2 * LEVEL_BITS)];
+                middle* m = slot.load(std::memory_order_relaxed);
+                if (nullptr == m)
+                {
+                    if (0 == value || nullptr == (m = new (std::nothrow) middle()))
+                        continue;
+                    slot.store(m, std::memory_order_release);
+                }
+                std::atomic<leaf*>& leaf_slot = m->leaves[(page >> LEVEL_BITS) & (LEVEL_SIZE - 1)];
+                leaf* l = leaf_slot.load(std::memory_order_relaxed);
+                if (nullptr == l)
+                {
+                    if (0 == value || nullptr == (l = new (std::nothrow) leaf()))
+                        continue;
+                    leaf_slot.store(l, std::memory_order_release);
+                }
+                l->pools[page & (LEVEL_SIZE - 1)].store(value, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    /**
+     * @brief 节点本地的区块来源：mmap 映射后 mbind 到 Node，mbind 不可用时退化为首次访问分配；
+     *        映射成功的区块登记到 numa_page_map，归还时清除
+     */
+    template <unsigned Node>
+    struct numa_chunk_source
+    {
+        static void* allocate(size_t& bytes, chunk_origin& origin)
+        {
+            void* p = mmap_chunk_source::allocate(bytes, origin);
+            if (nullptr != p && chunk_origin::mmap == origin)
+            {
+                numa_bind_memory(p, bytes, Node);
+                numa_page_map::set(p, bytes, Node);
+            }
+            return p;
+        }
+
+        static void release(void* p, const size_t bytes, const chunk_origin origin)
+        {
+            if (chunk_origin::malloc != origin)
+                numa_page_map::clear(p, bytes);
+            release_chunk(p, bytes, origin);
+        }
+    };
+
+    /**
+     * @brief NUMA 感知的二级配置器：每个节点各有一个多线程内存池，按调用线程所在的节点选择
+     *
+     * 节点 k 的内存池为 default_alloc_template<true, -1 - k, SizeClass, numa_chunk_source<k>>，
+     * 使用负的 ints 与用户自定义实例区分。超过 MaxNodes 的节点按取模归入已有的池。
+     * 释放的内存块按 numa_page_map 归还给分配它的池，跨节点释放不会让区块滞留在别的池中而无法 trim；
+     * 查不到登记的地址（大块、退回 malloc 的区块）归入释放线程所在节点的池。
+     */
+    template <unsigned MaxNodes = 8, typename SizeClass = default_size_classes>
+    class numa_alloc
+    {
+        static_assert(MaxNodes >= 1 && MaxNodes < 256, "numa_page_map stores pool indices in a byte");
+
+    public:
+        template <unsigned Node>
+        using node_pool = default_alloc_template<true, -1 - static_cast<int>(Node), SizeClass, numa_chunk_source<Node>>;
+
+        typedef typename node_pool<0>::stats_type stats_type;
+
+        static constexpr size_t ALIGN = SizeClass::ALIGN; ///< 对齐边界
+
+        static void* allocate(const size_t n)
+        {
+            return table().allocate[local_node()](n);
+        }
+
+        static void deallocate(void* p, const size_t n)
+        {
+            table().deallocate[owner_node(p)](p, n);
+        }
+
+        static void* reallocate(void* p, const size_t old_sz, const size_t new_sz)
+        {
+            return table().reallocate[owner_node(p)](p, old_sz, new_sz);
+        }
+
+        static void allocate_batch(const size_t n, const size_t count, void** out)
+        {
+            table().allocate_batch[local_node()](n, count, out);
+        }
+
+        /**
+         * @brief 按所属池把 ptrs 分成连续的段，每段整批归还
+         */
+        static void deallocate_batch(const size_t n, const size_t count, void* const* ptrs)
+        {
+            for (size_t begin = 0; begin < count;)
+            {
+                const unsigned node = owner_node(ptrs[begin]);
+                size_t end = begin + 1;
+                while (end < count && owner_node(ptrs[end]) == node)
+                    ++end;
+                table().deallocate_batch[node](n, end - begin, ptrs + begin);
+                begin = end;
+            }
+        }
+
+        static void* allocate_aligned(const size_t n, const size_t align)
+        {
+            return table().allocate_aligned[local_node()](n, align);
+        }
+
+        static void deallocate_aligned(void* p, const size_t n, const size_t align)
+        {
+            table().deallocate_aligned[owner_node(p)](p, n, align);
+        }
+
+        /**
+         * @brief 对所有节点的池执行 trim()
+         */
+        static size_t trim()
+        {
+            size_t released = 0;
+            for (unsigned node = 0; node < MaxNodes; ++node)
+                released += table().trim[node]();
+            return released;
+        }
+
+        /**
+         * @brief 节点 node 的池的统计快照
+         */
+        static stats_type stats(const unsigned node)
+        {
+            return table().stats[node % MaxNodes]();
+        }
+
+        /**
+         * @brief 当前线程使用的池的下标
+         */
+        static unsigned local_node()
+        {
+            return numa_current_node() % MaxNodes;
+        }
+
+        /**
+         * @brief 分配 p 的池的下标；p 不在任何节点池登记的区块中时返回 local_node()
+         */
+        static unsigned owner_node(const void* p)
+        {
+            const int pool = numa_page_map::find(p);
+            return pool >= 0 ? static_cast<unsigned>(pool) % MaxNodes : local_node();
+        }
+
+    private:
+        /**
+         * @brief 各节点池的函数表，下标为节点号
+         */
+        struct dispatch_table
+        {
+            void* (*allocate[MaxNodes])(size_t);
+            void (*deallocate[MaxNodes])(void*, size_t);
+            void* (*reallocate[MaxNodes])(void*, size_t, size_t);
+            void (*allocate_batch[MaxNodes])(size_t, size_t, void**);
+            void (*deallocate_batch[MaxNodes])(size_t, size_t, void* const*);
+            void* (*allocate_aligned[MaxNodes])(size_t, size_t);
+            void (*deallocate_aligned[MaxNodes])(void*, size_t, size_t);
+            size_t (*trim[MaxNodes])();
+            stats_type (*stats[MaxNodes])();
+        };
+
+        template <unsigned... Nodes>
+        static constexpr dispatch_table make_table(std::integer_sequence<unsigned, Nodes...>)
+        {
+            return {
+                {&node_pool<Nodes>::allocate...}, {&node_pool<Nodes>::deallocate...},
+                {&node_pool<Nodes>::reallocate...}, {&node_pool<Nodes>::allocate_batch...},
+                {&node_pool<Nodes>::deallocate_batch...}, {&node_pool<Nodes>::allocate_aligned...},
+                {&node_pool<Nodes>::deallocate_aligned...}, {&node_pool<Nodes>::trim...}, {&node_pool<Nodes>::stats...}
+            };
+        }
+
+        static const dispatch_table& table()
+        {
+            static constexpr dispatch_table t = make_table(std::make_integer_sequence<unsigned, MaxNodes>());
+            return t;
+        }
+    };
+}
+
+#endif
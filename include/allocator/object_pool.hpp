@@ -0,0 +1,560 @@
+#ifndef TINY_STL_OBJECT_POOL_HPP
+#define TINY_STL_OBJECT_POOL_HPP
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+
+#include "allocator.hpp"
+
+namespace Tiny
+{
+    /**
+     * @brief 定长对象池：为单一类型 T 提供对象的创建与回收
+     *
+     * 与 simple_alloc<T, alloc> 相比，所有槽位大小相同，不需要按尺寸类别查找自由链表。
+     * 结构与多线程二级配置器相同：每个线程持有私有缓存，缓存空时从中心无锁链表整批取出，
+     * 积压时整批归还；中心链表也为空时在锁内从区块（由 ChunkSource 申请，永不归还）连续切分。
+     *
+     * KeepConstructed 为 true 时对象归还后不析构，下一次 create() 直接取回原对象（忽略实参），
+     * 适合构造代价高、可以复用内部缓冲的类型；调用方负责重置需要重置的状态。
+     *
+     * set_capacity() 限制同时存活的对象数：达到上限时 create() 阻塞到有对象归还，try_create() 返回 nullptr。
+     * 同一 T 需要多个相互独立的池时以 inst 区分。
+     */
+    template <typename T, bool KeepConstructed = false, int inst = 0, typename ChunkSource = malloc_chunk_source>
+    class object_pool
+    {
+    public:
+        typedef T value_type;
+        typedef object_pool_stats stats_type; ///< 统计快照类型
+
+        static constexpr bool keep_constructed = KeepConstructed; ///< 归还的对象是否保持构造状态
+
+        enum
+        {
+            BATCH = 32, ///< 线程缓存与中心链表之间每次转移的对象数
+            CHUNK_BYTES = 64 * 1024 ///< 每个区块的目标字节数，至少容纳 BATCH 个对象
+        };
+
+    private:
+        /**
+         * @brief 不保留构造状态时，空闲槽位的前几个字节复用为链接字
+         */
+        union overlay_node
+        {
+            relaxed_link<overlay_node> free_list_link; ///< 以宽松原子方式读写，见 lock_free_free_list
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        /**
+         * @brief 保留构造状态时，对象在空闲期间仍然存活，链接字放在对象之后
+         */
+        struct keep_node
+        {
+            alignas(T) unsigned char storage[sizeof(T)];
+            relaxed_link<keep_node> free_list_link; ///< 以宽松原子方式读写，见 lock_free_free_list
+            bool constructed; ///< 槽位中是否已有构造好的对象
+        };
+
+        typedef std::conditional_t<KeepConstructed, keep_node, overlay_node> node;
+        typedef pool_counters<1> counters_type;
+
+        /**
+         * @brief 区块头，位于每个区块的起始处
+         */
+        struct chunk_header
+        {
+            chunk_header* next; ///< 下一个区块
+            size_t size; ///< 区块总字节数
+            chunk_origin origin; ///< 区块来源
+        };
+
+        /**
+         * @brief 线程私有缓存
+         */
+        struct thread_cache
+        {
+            node* free_list = nullptr; ///< 线程私有的空闲槽位链表
+            size_t length = 0; ///< 链表长度
+            counters_type counters; ///< 本线程的统计计数
+            thread_cache* prev = nullptr; ///< 统计登记表中的前一个缓存
+            thread_cache* next = nullptr; ///< 统计登记表中的后一个缓存
+
+            /**
+             * @brief 线程首次使用对象池时将缓存登记到统计登记表
+             */
+            thread_cache();
+
+            /**
+             * @brief 线程退出时将缓存中的槽位全部归还中心链表，并把计数并入全局计数
+             */
+            ~thread_cache();
+        };
+
+    public:
+        /**
+         * @brief 创建对象；已达容量上限时阻塞，直到其他线程归还对象
+         *
+         * 构造函数抛出异常时槽位与容量配额都会退回，异常原样传出。
+         */
+        template <typename... Args>
+        static T* create(Args&&... args)
+        {
+            if (!reserve())
+                wait_for_capacity();
+            return construct_in(get_node(), std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief 创建对象；已达容量上限时立即返回 nullptr
+         */
+        template <typename... Args>
+        static T* try_create(Args&&... args)
+        {
+            if (!reserve())
+            {
+                if constexpr (alloc_stats_enabled)
+                    rejected_creates.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            return construct_in(get_node(), std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief 归还由 create() 或 try_create() 得到的对象，p 为空时为空操作
+         */
+        static void destroy(T* p)
+        {
+            if (nullptr == p)
+                return;
+            if constexpr (!KeepConstructed)
+                Tiny::destroy(p);
+            put_node(reinterpret_cast<node*>(p));
+            release();
+        }
+
+        /**
+         * @brief 设置同时存活对象数的上限并返回旧值，0 表示不限；须在创建对象之前设置
+         */
+        static size_t set_capacity(const size_t n)
+        {
+            const size_t old = capacity.exchange(n);
+            std::lock_guard<std::mutex> lock(wait_mutex);
+            not_full.notify_all();
+            return old;
+        }
+
+        /**
+         * @brief 汇总各计数器，返回统计快照
+         */
+        static stats_type stats();
+
+    private:
+        /**
+         * @brief 占用一个容量配额，已达上限时返回 false；不限容量时为空操作
+         */
+        static bool reserve()
+        {
+            const size_t limit = capacity.load(std::memory_order_relaxed);
+            if (0 == limit)
+                return true;
+            size_t n = live.load();
+            do
+            {
+                if (n >= limit)
+                    return false;
+            }
+            while (!live.compare_exchange_weak(n, n + 1));
+            return true;
+        }
+
+        /**
+         * @brief 退回一个容量配额，有线程在等待时唤醒其中一个
+         */
+        static void release()
+        {
+            if (0 == capacity.load(std::memory_order_relaxed))
+                return;
+            live.fetch_sub(1);
+            // waiters 在 wait_mutex 内递增后才检查配额，此处读到 0 说明等待者必然能看到这次退回
+            if (0 != waiters.load())
+            {
+                std::lock_guard<std::mutex> lock(wait_mutex);
+                not_full.notify_one();
+            }
+        }
+
+        /**
+         * @brief 阻塞直到占到一个容量配额
+         */
+        static void wait_for_capacity();
+
+        /**
+         * @brief 在槽位中构造对象；保留构造状态且槽位中已有对象时直接返回
+         */
+        template <typename... Args>
+        static T* construct_in(node* p, Args&&... args)
+        {
+            T* result = reinterpret_cast<T*>(p->storage);
+            if constexpr (KeepConstructed)
+            {
+                if (p->constructed)
+                    return result;
+            }
+            try
+            {
+                Tiny::construct(result, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                put_node(p);
+                release();
+                throw;
+            }
+            if constexpr (KeepConstructed)
+                p->constructed = true;
+            return result;
+        }
+
+        /**
+         * @brief 从线程缓存取出一个槽位，缓存为空时整批补充；申请区块失败时退回容量配额并抛出异常
+         */
+        static node* get_node()
+        {
+            thread_cache& tc = cache;
+            node* p = tc.free_list;
+            if (nullptr == p)
+            {
+                p = refill(tc);
+            }
+            else
+            {
+                tc.free_list = p->free_list_link;
+                --tc.length;
+                if constexpr (alloc_stats_enabled)
+                    tc.counters.cached_bytes.sub(sizeof(node));
+            }
+            if constexpr (alloc_stats_enabled)
+                tc.counters.allocations[0].add(1);
+            return p;
+        }
+
+        /**
+         * @brief 把槽位放回线程缓存，积压超过两批时归还一批给中心链表
+         */
+        static void put_node(node* p)
+        {
+            thread_cache& tc = cache;
+            if constexpr (alloc_stats_enabled)
+            {
+                tc.counters.deallocations[0].add(1);
+                tc.counters.cached_bytes.add(sizeof(node));
+            }
+            p->free_list_link = tc.free_list;
+            tc.free_list = p;
+            if (++tc.length > 2 * BATCH)
+                release_to_central(tc, BATCH);
+        }
+
+        /**
+         * @brief 线程缓存为空时从中心链表整批取出，中心链表也为空时从区块切分；返回其中一个槽位
+         */
+        static node* refill(thread_cache& tc);
+
+        /**
+         * @brief 将线程缓存头部的 n 个槽位整段归还中心链表
+         */
+        static void release_to_central(thread_cache& tc, size_t n);
+
+        /**
+         * @brief 在锁内从区块切分至多 n 个槽位，串成以 nullptr 结尾的链返回，count 为实际数量
+         */
+        static node* carve(size_t n, size_t& count);
+
+        /**
+         * @brief 把一组计数累加进统计快照
+         */
+        static void collect(stats_type& result, const counters_type& counters);
+
+        static lock_free_free_list<node> central_list; ///< 中心无锁空闲链表
+        static std::atomic<size_t> central_length; ///< 中心链表中的槽位数
+        static thread_local thread_cache cache; ///< 当前线程的本地缓存
+        static std::mutex chunk_mutex; ///< 保护区块切分状态（start_free、end_free、chunk_list 及区块计数）
+        static node* start_free; ///< 当前区块中尚未切分部分的起始地址
+        static node* end_free; ///< 当前区块中尚未切分部分的结束地址
+        static chunk_header* chunk_list; ///< 从系统申请的全部区块
+        static size_t heap_size; ///< 从系统申请的字节数
+        static size_t chunk_allocs; ///< 申请区块的次数
+        static size_t chunk_origins[3]; ///< 按来源统计申请的区块数
+        static std::atomic<size_t> capacity; ///< 同时存活对象数的上限，0 表示不限
+        static std::atomic<size_t> live; ///< 限制容量时已占用的配额数
+        static std::atomic<size_t> waiters; ///< 正在等待配额的线程数
+        static std::mutex wait_mutex; ///< 与 not_full 配合的互斥锁
+        static std::condition_variable not_full; ///< 有配额退回时通知等待者
+        static std::atomic<size_t> blocked_creates; ///< create() 等待配额的次数
+        static std::atomic<size_t> rejected_creates; ///< try_create() 因无配额失败的次数
+        static counters_type global_counters; ///< 已退出线程的累积计数
+        static thread_cache* cache_registry; ///< 所有存活线程缓存组成的统计登记表
+        static std::mutex registry_mutex; ///< 保护统计登记表与全局计数的合并
+    };
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    lock_free_free_list<typename object_pool<T, KeepConstructed, inst, ChunkSource>::node>
+    object_pool<T, KeepConstructed, inst, ChunkSource>::central_list; ///< 中心无锁空闲链表
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    std::atomic<size_t> object_pool<T, KeepConstructed, inst, ChunkSource>::central_length{0}; ///< 中心链表长度
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    thread_local typename object_pool<T, KeepConstructed, inst, ChunkSource>::thread_cache
+    object_pool<T, KeepConstructed, inst, ChunkSource>::cache; ///< 线程本地缓存
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    std::mutex object_pool<T, KeepConstructed, inst, ChunkSource>::chunk_mutex; ///< 区块切分互斥锁
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    typename object_pool<T, KeepConstructed, inst, ChunkSource>::node*
+    object_pool<T, KeepConstructed, inst, ChunkSource>::start_free = nullptr; ///< 未切分部分的起始地址
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    typename object_pool<T, KeepConstructed, inst, ChunkSource>::node*
+    object_pool<T, KeepConstructed, inst, ChunkSource>::end_free = nullptr; ///< 未切分部分的结束地址
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    typename object_pool<T, KeepConstructed, inst, ChunkSource>::chunk_header*
+    object_pool<T, KeepConstructed, inst, ChunkSource>::chunk_list = nullptr; ///< 区块链表
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    size_t object_pool<T, KeepConstructed, inst, ChunkSource>::heap_size = 0; ///< 申请的字节数
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    size_t object_pool<T, KeepConstructed, inst, ChunkSource>::chunk_allocs = 0; ///< 区块申请次数
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    size_t object_pool<T, KeepConstructed, inst, ChunkSource>::chunk_origins[3] = {}; ///< 各来源区块数
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    std::atomic<size_t> object_pool<T, KeepConstructed, inst, ChunkSource>::capacity{0}; ///< 容量上限
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    std::atomic<size_t> object_pool<T, KeepConstructed, inst, ChunkSource>::live{0}; ///< 已占用配额
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    std::atomic<size_t> object_pool<T, KeepConstructed, inst, ChunkSource>::waiters{0}; ///< 等待者数
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    std::mutex object_pool<T, KeepConstructed, inst, ChunkSource>::wait_mutex; ///< 等待互斥锁
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    std::condition_variable object_pool<T, KeepConstructed, inst, ChunkSource>::not_full; ///< 配额退回通知
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    std::atomic<size_t> object_pool<T, KeepConstructed, inst, ChunkSource>::blocked_creates{0}; ///< 等待次数
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    std::atomic<size_t> object_pool<T, KeepConstructed, inst, ChunkSource>::rejected_creates{0}; ///< 拒绝次数
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    typename object_pool<T, KeepConstructed, inst, ChunkSource>::counters_type
+    object_pool<T, KeepConstructed, inst, ChunkSource>::global_counters; ///< 全局计数
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    typename object_pool<T, KeepConstructed, inst, ChunkSource>::thread_cache*
+    object_pool<T, KeepConstructed, inst, ChunkSource>::cache_registry = nullptr; ///< 线程缓存登记表
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    std::mutex object_pool<T, KeepConstructed, inst, ChunkSource>::registry_mutex; ///< 登记表互斥锁
+
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    object_pool<T, KeepConstructed, inst, ChunkSource>::thread_cache::thread_cache()
+    {
+        if constexpr (alloc_stats_enabled)
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            next = cache_registry;
+            if (nullptr != next)
+                next->prev = this;
+            cache_registry = this;
+        }
+    }
+
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    object_pool<T, KeepConstructed, inst, ChunkSource>::thread_cache::~thread_cache()
+    {
+        if (0 != length)
+            release_to_central(*this, length);
+
+        if constexpr (alloc_stats_enabled)
+        {
+            // 计数并入全局计数后再从登记表摘除，stats() 在任意时刻都不会漏算或重算
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            global_counters.allocations[0].add(counters.allocations[0].load());
+            global_counters.deallocations[0].add(counters.deallocations[0].load());
+            global_counters.refills.add(counters.refills.load());
+            if (nullptr != prev)
+                prev->next = next;
+            else
+                cache_registry = next;
+            if (nullptr != next)
+                next->prev = prev;
+        }
+    }
+
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    void object_pool<T, KeepConstructed, inst, ChunkSource>::wait_for_capacity()
+    {
+        if constexpr (alloc_stats_enabled)
+            blocked_creates.fetch_add(1, std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(wait_mutex);
+        waiters.fetch_add(1);
+        not_full.wait(lock, [] { return reserve(); });
+        waiters.fetch_sub(1);
+    }
+
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    typename object_pool<T, KeepConstructed, inst, ChunkSource>::node*
+    object_pool<T, KeepConstructed, inst, ChunkSource>::refill(thread_cache& tc)
+    {
+        size_t count = 0;
+        node* chain = central_list.pop(BATCH, count);
+        if (nullptr != chain)
+        {
+            central_length.fetch_sub(count, std::memory_order_relaxed);
+        }
+        else
+        {
+            try
+            {
+                chain = carve(BATCH, count);
+            }
+            catch (...)
+            {
+                release();
+                throw;
+            }
+        }
+        if constexpr (alloc_stats_enabled)
+        {
+            tc.counters.refills.add(1);
+            tc.counters.cached_bytes.add((count - 1) * sizeof(node));
+        }
+        // 第一个槽位交给调用者，其余挂入线程缓存
+        tc.free_list = chain->free_list_link;
+        tc.length = count - 1;
+        return chain;
+    }
+
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    void object_pool<T, KeepConstructed, inst, ChunkSource>::release_to_central(thread_cache& tc, const size_t n)
+    {
+        node* first = tc.free_list;
+        node* last = first;
+        for (size_t i = 1; i < n; ++i)
+            last = last->free_list_link;
+        tc.free_list = last->free_list_link;
+        tc.length -= n;
+        if constexpr (alloc_stats_enabled)
+            tc.counters.cached_bytes.sub(n * sizeof(node));
+        central_length.fetch_add(n, std::memory_order_relaxed);
+        central_list.push(first, last);
+    }
+
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    typename object_pool<T, KeepConstructed, inst, ChunkSource>::node*
+    object_pool<T, KeepConstructed, inst, ChunkSource>::carve(const size_t n, size_t& count)
+    {
+        std::lock_guard<std::mutex> lock(chunk_mutex);
+        if (start_free == end_free)
+        {
+            // 区块头之后按 node 的对齐取整，区块来源返回的地址只保证基本对齐，因此多申请 alignof(node) 字节
+            const size_t objs = std::max<size_t>(CHUNK_BYTES / sizeof(node), BATCH);
+            size_t bytes = sizeof(chunk_header) + alignof(node) + objs * sizeof(node);
+            chunk_origin origin = chunk_origin::malloc;
+            auto chunk = static_cast<chunk_header*>(ChunkSource::allocate(bytes, origin));
+            if (nullptr == chunk)
+            {
+                chunk = static_cast<chunk_header*>(malloc_alloc::allocate(bytes)); // 失败时走 OOM 重试策略
+                origin = chunk_origin::malloc;
+            }
+            chunk->next = chunk_list;
+            chunk->size = bytes;
+            chunk->origin = origin;
+            chunk_list = chunk;
+            heap_size += bytes;
+            if constexpr (alloc_stats_enabled)
+            {
+                ++chunk_allocs;
+                ++chunk_origins[static_cast<size_t>(origin)];
+            }
+            const auto begin = reinterpret_cast<uintptr_t>(chunk + 1);
+            const auto end = reinterpret_cast<uintptr_t>(chunk) + bytes;
+            start_free = reinterpret_cast<node*>((begin + alignof(node) - 1) & ~(uintptr_t(alignof(node)) - 1));
+            end_free = start_free + (end - reinterpret_cast<uintptr_t>(start_free)) / sizeof(node);
+        }
+
+        count = std::min<size_t>(n, end_free - start_free);
+        node* chain = start_free;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if constexpr (KeepConstructed)
+                start_free[i].constructed = false;
+            start_free[i].free_list_link = i + 1 < count ? start_free + i + 1 : nullptr;
+        }
+        start_free += count;
+        return chain;
+    }
+
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    void object_pool<T, KeepConstructed, inst, ChunkSource>::collect(stats_type& result, const counters_type& counters)
+    {
+        result.allocations[0] += counters.allocations[0].load();
+        result.deallocations[0] += counters.deallocations[0].load();
+        result.refills += counters.refills.load();
+        result.thread_cache_bytes += counters.cached_bytes.load();
+    }
+
+
+    template <typename T, bool KeepConstructed, int inst, typename ChunkSource>
+    typename object_pool<T, KeepConstructed, inst, ChunkSource>::stats_type
+    object_pool<T, KeepConstructed, inst, ChunkSource>::stats()
+    {
+        stats_type result;
+        result.capacity = capacity.load(std::memory_order_relaxed);
+        result.live_objects = live.load(std::memory_order_relaxed); // 关闭统计时只在限制容量时可知
+        if constexpr (alloc_stats_enabled)
+        {
+            {
+                std::lock_guard<std::mutex> lock(registry_mutex);
+                collect(result, global_counters);
+                for (const thread_cache* tc = cache_registry; nullptr != tc; tc = tc->next)
+                    collect(result, tc->counters);
+            }
+            result.live_objects = result.allocations[0] - result.deallocations[0];
+            result.free_list_bytes = central_length.load(std::memory_order_relaxed) * sizeof(node);
+            result.blocked_creates = blocked_creates.load(std::memory_order_relaxed);
+            result.rejected_creates = rejected_creates.load(std::memory_order_relaxed);
+            result.oom_handler_calls = malloc_alloc::stats().oom_handler_calls;
+
+            std::lock_guard<std::mutex> lock(chunk_mutex);
+            result.chunk_allocs = chunk_allocs;
+            result.mmap_chunks = chunk_origins[static_cast<size_t>(chunk_origin::mmap)];
+            result.huge_page_chunks = chunk_origins[static_cast<size_t>(chunk_origin::huge_page)];
+            result.pool_bytes = static_cast<size_t>(end_free - start_free) * sizeof(node);
+            result.heap_size = heap_size;
+        }
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef TINY_STL_SIMD_MEMOPS_HPP
+#define TINY_STL_SIMD_MEMOPS_HPP
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+///< 是否启用 SIMD 流式填充与拷贝，定义为 0 时 stream_fill / stream_copy 只使用标量实现
+#ifndef TINY_STL_SIMD
+#define TINY_STL_SIMD 1
+#endif
+
+///< 使用非临时存储的最小字节数：更小的区间直接写入缓存，之后大概率马上被读取
+#ifndef TINY_STL_STREAMING_THRESHOLD
+#define TINY_STL_STREAMING_THRESHOLD (1024 * 1024)
+#endif
+
+#if TINY_STL_SIMD && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define TINY_STL_HAS_X86_SIMD 1
+#else
+#define TINY_STL_HAS_X86_SIMD 0
+#endif
+
+namespace Tiny
+{
+    constexpr size_t STREAMING_THRESHOLD = TINY_STL_STREAMING_THRESHOLD; ///< 流式存储阈值
+
+    /**
+     * @brief 可用的指令集级别
+     */
+    enum class simd_level : unsigned char
+    {
+        scalar, ///< 标量实现，所有平台可用
+        sse2, ///< 16 字节非临时存储
+        avx2 ///< 32 字节非临时存储
+    };
+
+    /**
+     * @brief 运行时通过 CPUID 检测的指令集级别，首次调用后缓存
+     */
+    inline simd_level cpu_simd_level()
+    {
+#if TINY_STL_HAS_X86_SIMD
+        static const simd_level level = []
+        {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return simd_level::avx2;
+            if (__builtin_cpu_supports("sse2"))
+                return simd_level::sse2;
+            return simd_level::scalar;
+        }();
+        return level;
+#else
+        return simd_level::scalar;
+#endif
+    }
+
+    namespace simd_detail
+    {
+        /**
+         * @brief 按字节写入图样：dst[i] 取 value[(offset + i) % size]，用于首尾不足一个向量的部分
+         */
+        inline void fill_bytes(unsigned char* dst, const size_t bytes, const unsigned char* value, const size_t size,
+                               const size_t offset)
+        {
+            for (size_t i = 0; i < bytes; ++i)
+                dst[i] = value[(offset + i) % size];
+        }
+
+        /**
+         * @brief 生成从相位 offset 开始的 32 字节图样，size 必须整除 32
+         */
+        inline void make_pattern(unsigned char (&pattern)[32], const unsigned char* value, const size_t size,
+                                 const size_t offset)
+        {
+            fill_bytes(pattern, 32, value, size, offset);
+        }
+
+#if TINY_STL_HAS_X86_SIMD
+        __attribute__((target("avx2"))) inline void stream_fill_avx2(unsigned char* dst, const size_t bytes,
+                                                                     const unsigned char* value, const size_t size)
+        {
+            const size_t head = std::min<size_t>((32 - reinterpret_cast<uintptr_t>(dst) % 32) % 32, bytes);
+            fill_bytes(dst, head, value, size, 0);
+            unsigned char pattern[32];
+            make_pattern(pattern, value, size, head);
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+            size_t i = head;
+            for (; i + 32 <= bytes; i += 32)
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v);
+            _mm_sfence();
+            fill_bytes(dst + i, bytes - i, value, size, i);
+        }
+
+        __attribute__((target("sse2"))) inline void stream_fill_sse2(unsigned char* dst, const size_t bytes,
+                                                                     const unsigned char* value, const size_t size)
+        {
+            const size_t head = std::min<size_t>((16 - reinterpret_cast<uintptr_t>(dst) % 16) % 16, bytes);
+            fill_bytes(dst, head, value, size, 0);
+            unsigned char pattern[32];
+            make_pattern(pattern, value, size, head);
+            // size 不超过 16 时 16 字节图样即可重复；size 为 32 时交替写入前后两半
+            const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+            const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern + 16));
+            size_t i = head;
+            for (; i + 32 <= bytes; i += 32)
+            {
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), lo);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 16), hi);
+            }
+            _mm_sfence();
+            fill_bytes(dst + i, bytes - i, value, size, i);
+        }
+
+        __attribute__((target("avx2"))) inline void stream_copy_avx2(unsigned char* dst, const unsigned char* src,
+                                                                     const size_t bytes)
+        {
+            const size_t head = std::min<size_t>((32 - reinterpret_cast<uintptr_t>(dst) % 32) % 32, bytes);
+            std::memcpy(dst, src, head);
+            size_t i = head;
+            for (; i + 128 <= bytes; i += 128)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32));
+                const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 64));
+                const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 96));
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), a);
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 32), b);
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 64), c);
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i + 96), d);
+            }
+            for (; i + 32 <= bytes; i += 32)
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+            _mm_sfence();
+            std::memcpy(dst + i, src + i, bytes - i);
+        }
+
+        __attribute__((target("sse2"))) inline void stream_copy_sse2(unsigned char* dst, const unsigned char* src,
+                                                                     const size_t bytes)
+        {
+            const size_t head = std::min<size_t>((16 - reinterpret_cast<uintptr_t>(dst) % 16) % 16, bytes);
+            std::memcpy(dst, src, head);
+            size_t i = head;
+            for (; i + 64 <= bytes; i += 64)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 32));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 48));
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i), a);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 16), b);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 32), c);
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i + 48), d);
+            }
+            for (; i + 16 <= bytes; i += 16)
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dst + i),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+            _mm_sfence();
+            std::memcpy(dst + i, src + i, bytes - i);
+        }
+#endif
+    }
+
+    /**
+     * @brief 判断 size 字节的元素能否由 stream_fill 按 32 字节图样填充
+     */
+    constexpr bool stream_fillable(const size_t size)
+    {
+        return 0 != size && size <= 32 && 0 == 32 % size;
+    }
+
+    /**
+     * @brief 把 count 个 size 字节的值 value 写入 dst，使用非临时存储绕过缓存
+     *
+     * size 必须满足 stream_fillable。level 默认取 CPUID 检测结果，测试时可显式指定；
+     * 标量级别按普通存储写入。
+     */
+    inline void stream_fill(void* dst, const void* value, const size_t size, const size_t count,
+                            const simd_level level = cpu_simd_level())
+    {
+        auto* d = static_cast<unsigned char*>(dst);
+        const auto* v = static_cast<const unsigned char*>(value);
+        const size_t bytes = size * count;
+#if TINY_STL_HAS_X86_SIMD
+        if (simd_level::avx2 == level)
+            return simd_detail::stream_fill_avx2(d, bytes, v, size);
+        if (simd_level::sse2 == level)
+            return simd_detail::stream_fill_sse2(d, bytes, v, size);
+#else
+        (void)level;
+#endif
+        if (1 == size)
+        {
+            std::memset(d, *v, bytes);
+            return;
+        }
+        unsigned char pattern[32];
+        simd_detail::make_pattern(pattern, v, size, 0);
+        size_t i = 0;
+        for (; i + 32 <= bytes; i += 32)
+            std::memcpy(d + i, pattern, 32);
+        simd_detail::fill_bytes(d + i, bytes - i, v, size, i);
+    }
+
+    /**
+     * @brief 把 [src, src + bytes) 拷贝到不重叠的 dst，使用非临时存储绕过缓存
+     */
+    inline void stream_copy(void* dst, const void* src, const size_t bytes, const simd_level level = cpu_simd_level())
+    {
+        auto* d = static_cast<unsigned char*>(dst);
+        const auto* s = static_cast<const unsigned char*>(src);
+#if TINY_STL_HAS_X86_SIMD
+        if (simd_level::avx2 == level)
+            return simd_detail::stream_copy_avx2(d, s, bytes);
+        if (simd_level::sse2 == level)
+            return simd_detail::stream_copy_sse2(d, s, bytes);
+#else
+        (void)level;
+#endif
+        std::memcpy(d, s, bytes);
+    }
+}
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef TINY_STL_SIZE_CLASS_HPP
+#define TINY_STL_SIZE_CLASS_HPP
+#include <cstddef>
+
+namespace Tiny
+{
+    /**
+     * @brief 尺寸类别策略需提供的接口：
+     *        ALIGN 块对齐与最小块大小，MAX_BYTES 池化的最大请求，NFREELISTS 类别数量，
+     *        index(bytes) 请求大小到类别下标的映射，size(index) 类别下标对应的块大小
+     */
+
+    /**
+     * @brief 默认尺寸类别：8 字节对齐，8 ~ 128 字节共 16 个等差类别（SGI 布局）
+     */
+    struct default_size_classes
+    {
+        static constexpr size_t ALIGN = 8; ///< 对齐边界
+        static constexpr size_t MAX_BYTES = 128; ///< 池化的最大请求字节数
+        static constexpr size_t NFREELISTS = MAX_BYTES / ALIGN; ///< 自由链表数量
+
+        /**
+         * @brief 计算请求大小对应的类别下标
+         */
+        static constexpr size_t index(const size_t bytes)
+        {
+            return (bytes + ALIGN - 1) / ALIGN - 1;
+        }
+
+        /**
+         * @brief 计算类别下标对应的块大小
+         */
+        static constexpr size_t size(const size_t index)
+        {
+            return (index + 1) * ALIGN;
+        }
+    };
+
+    /**
+     * @brief 向下取整的以 2 为底的对数
+     */
+    constexpr size_t floor_log2(size_t n)
+    {
+#if defined(__GNUC__)
+        return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(n);
+#else
+        size_t result = 0;
+        while (n >>= 1)
+            ++result;
+        return result;
+#endif
+    }
+
+    /**
+     * @brief 几何尺寸类别（仿 tcmalloc）：8 * Align 以内按 Align 等差划分，
+     *        之后每个 [2^k, 2^(k+1)) 区间再等分为 4 个类别，直到 MaxBytes
+     *
+     * 以默认参数为例：16、32、…、128，160、192、224、256，320、…、32768，共 40 个类别，
+     * 相邻类别的内部碎片不超过 25%。
+     */
+    template <size_t Align = 16, size_t MaxBytes = 32768>
+    struct geometric_size_classes
+    {
+        static_assert(Align >= sizeof(void*) && 0 == (Align & (Align - 1)), "Align must be a power of 2");
+        static_assert(0 == (MaxBytes & (MaxBytes - 1)) && MaxBytes >= 8 * Align,
+                      "MaxBytes must be a power of 2 no smaller than 8 * Align");
+
+        static constexpr size_t ALIGN = Align; ///< 对齐边界
+        static constexpr size_t MAX_BYTES = MaxBytes; ///< 池化的最大请求字节数
+
+    private:
+        static constexpr size_t SMALL_BYTES = 8 * Align; ///< 等差区间的上界
+        static constexpr size_t SMALL_CLASSES = 8; ///< 等差区间的类别数
+        static constexpr size_t SMALL_SHIFT = floor_log2(SMALL_BYTES);
+        static constexpr size_t CLASSES_PER_DOUBLING = 4; ///< 每个倍增区间的类别数
+
+    public:
+        ///< 自由链表数量
+        static constexpr size_t NFREELISTS =
+            SMALL_CLASSES + CLASSES_PER_DOUBLING * (floor_log2(MaxBytes) - SMALL_SHIFT);
+
+        /**
+         * @brief 计算请求大小对应的类别下标
+         */
+        static constexpr size_t index(const size_t bytes)
+        {
+            if (bytes <= SMALL_BYTES)
+                return (bytes + Align - 1) / Align - 1;
+            const size_t k = floor_log2(bytes - 1); // 2^k < bytes <= 2^(k+1)
+            const size_t step = static_cast<size_t>(1) << (k - 2);
+            const size_t sub = (bytes - (static_cast<size_t>(1) << k) + step - 1) / step - 1;
+            return SMALL_CLASSES + CLASSES_PER_DOUBLING * (k - SMALL_SHIFT) + sub;
+        }
+
+        /**
+         * @brief 计算类别下标对应的块大小
+         */
+        static constexpr size_t size(const size_t index)
+        {
+            if (index < SMALL_CLASSES)
+                return (index + 1) * Align;
+            const size_t k = SMALL_SHIFT + (index - SMALL_CLASSES) / CLASSES_PER_DOUBLING;
+            const size_t sub = (index - SMALL_CLASSES) % CLASSES_PER_DOUBLING;
+            return (static_cast<size_t>(1) << k) + (sub + 1) * (static_cast<size_t>(1) << (k - 2));
+        }
+    };
+}
+
+#endif
@@ -120,7 +120,7 @@ namespace Tiny {
     };
 
     template<typename T, typename Alloc=alloc, size_t BufSize = 0>
-    class deque {
+    class deque : protected alloc_base<Alloc> {
     public:
         /**基本数据类型*/
         typedef T value_type;
@@ -129,6 +129,9 @@ namespace Tiny {
         typedef const value_type &const_reference;
         typedef size_t size_type;
         typedef ptrdiff_t difference_type;
+        typedef Alloc allocator_type;
+
+        using alloc_base<Alloc>::get_allocator;
 
     public:
         /**迭代器*/
@@ -142,11 +145,11 @@ namespace Tiny {
         typedef simple_alloc<pointer, Alloc> map_allocator;
 
         pointer allocate_node() {
-            return data_allocator::allocate(_deque_iterator<T, T &, T *, BufSize>::buffer_size());
+            return data_allocator::allocate(this->allocator(), _deque_iterator<T, T &, T *, BufSize>::buffer_size());
         }
 
         void deallocate_node(pointer p) {
-            data_allocator::deallocate(p, _deque_iterator<T, T &, T *, BufSize>::buffer_size());
+            data_allocator::deallocate(this->allocator(), p, _deque_iterator<T, T &, T *, BufSize>::buffer_size());
         }
 
 
@@ -186,10 +189,64 @@ namespace Tiny {
         size_type default_Node_size = 8;
 
     public:
-        deque(int n, const value_type &x) : start(), finish(), map(nullptr), map_size(0) {
+        explicit deque(const Alloc &a = Alloc()) : alloc_base<Alloc>(a), start(), finish(), map(nullptr), map_size(0) {
+            create_map_and_node(0);
+        }
+
+        deque(int n, const value_type &x, const Alloc &a = Alloc())
+                : alloc_base<Alloc>(a), start(), finish(), map(nullptr), map_size(0) {
             fill_initialize(n, x);
         }
 
+        deque(const deque &x) : deque(x.get_allocator()) {
+            for (iterator i = x.begin(); i != x.end(); ++i)
+                push_back(*i);
+        }
+
+        /**接管 x 的缓冲区与中控器，x 换成一个新建的空 deque*/
+        deque(deque &&x) : deque(x.get_allocator()) { swap(x); }
+
+        deque &operator=(const deque &x) {
+            if (this != &x) {
+                clear();
+                for (iterator i = x.begin(); i != x.end(); ++i)
+                    push_back(*i);
+            }
+            return *this;
+        }
+
+        /**分配器相同时交换全部空间，否则逐个复制元素；之后 x 为空*/
+        deque &operator=(deque &&x) {
+            if (this == &x)
+                return *this;
+            bool same = true;
+            if constexpr (!std::is_empty<Alloc>::value)
+                same = this->allocator() == x.allocator();
+            if (same) {
+                clear();
+                swap(x);
+            } else {
+                *this = static_cast<const deque &>(x);
+                x.clear();
+            }
+            return *this;
+        }
+
+        void swap(deque &x) noexcept {
+            std::swap(static_cast<alloc_base<Alloc> &>(*this), static_cast<alloc_base<Alloc> &>(x));
+            std::swap(start, x.start);
+            std::swap(finish, x.finish);
+            std::swap(map, x.map);
+            std::swap(map_size, x.map_size);
+            std::swap(default_Node_size, x.default_Node_size);
+        }
+
+        ~deque() {
+            clear();
+            deallocate_node(start.first);
+            map_allocator::deallocate(this->allocator(), map, map_size);
+        }
+
         iterator begin() { return start; }
 
         iterator begin() const { return start; }
@@ -232,6 +289,9 @@ namespace Tiny {
 
     };
 
+    template<typename T, typename Alloc, size_t BufSize>
+    void swap(deque<T, Alloc, BufSize> &x, deque<T, Alloc, BufSize> &y) noexcept { x.swap(y); }
+
     template<typename T, typename Alloc, size_t BufSize>
     typename deque<T, Alloc, BufSize>::iterator
     deque<T, Alloc, BufSize>::insert_aux(deque::iterator pos, const value_type &x) {
@@ -246,7 +306,7 @@ namespace Tiny {
             pos = start + index;
             iterator pos1 = pos;
             ++pos1;
-            std::copy(front2, pos1, front1);
+            std::move(front2, pos1, front1);
         } else {
             push_back(back());
             iterator back1 = finish;
@@ -254,9 +314,9 @@ namespace Tiny {
             iterator back2 = back1;
             --back2;
             pos = start + index;
-            std::copy_backward(pos, back2, back1);
+            std::move_backward(pos, back2, back1);
         }
-        *pos = x_copy;
+        *pos = std::move(x_copy);
         return pos;
     }
 
@@ -287,19 +347,19 @@ namespace Tiny {
             difference_type n = last - first;
             difference_type elems_before = first - start;
             if (elems_before < (size() - n) / 2) {
-                std::copy_backward(start, first, last);
+                std::move_backward(start, first, last);
                 iterator new_start = start + n;
-                destroy(start, new_start);
+                Tiny::destroy(start, new_start);
 
                 for (map_pointer cur = start.node; cur < new_start.node; ++cur)
-                    data_allocator::deallocate(*cur, _deque_iterator<T, T &, T *, BufSize>::buffer_size());
+                    data_allocator::deallocate(this->allocator(), *cur, _deque_iterator<T, T &, T *, BufSize>::buffer_size());
                 start = new_start;
             } else {
-                std::copy(last, finish, first);
+                std::move(last, finish, first);
                 iterator new_finish = finish - n;
-                destroy(new_finish, finish);
+                Tiny::destroy(new_finish, finish);
                 for (map_pointer cur = new_finish.node + 1; cur <= finish.node; ++cur)
-                    data_allocator::deallocate(*cur, _deque_iterator<T, T &, T *, BufSize>::buffer_size());
+                    data_allocator::deallocate(this->allocator(), *cur, _deque_iterator<T, T &, T *, BufSize>::buffer_size());
                 finish = new_finish;
             }
             return start + elems_before;
@@ -312,10 +372,10 @@ namespace Tiny {
         ++next;
         difference_type index = pos - start;
         if (index < (size() >> 1)) {
-            std::copy_backward(start, pos, next);
+            std::move_backward(start, pos, next);
             pop_front();
         } else {
-            std::copy(next, finish, pos);
+            std::move(next, finish, pos);
             pop_back();
         }
         return start + index;
@@ -323,17 +383,21 @@ namespace Tiny {
 
     template<typename T, typename Alloc, size_t BufSize>
     void deque<T, Alloc, BufSize>::clear() {
-        for (map_pointer node = start.node + 1; node < finish.node; ++node) {
-            destroy(*node, *node + _deque_iterator<T, T &, T *, BufSize>::buffer_size());
-            data_allocator::deallocate(*node, _deque_iterator<T, T &, T *, BufSize>::buffer_size());
-        }
+        for (map_pointer node = start.node + 1; node < finish.node; ++node)
+            Tiny::destroy(*node, *node + _deque_iterator<T, T &, T *, BufSize>::buffer_size());
+        if (start.node + 1 < finish.node)/**中间的缓冲区在 map 中连续，整批归还*/
+            data_allocator::deallocate_batch(this->allocator(), _deque_iterator<T, T &, T *, BufSize>::buffer_size(),
+                                             finish.node - start.node - 1, start.node + 1);
         if (start.node != finish.node) {
-            destroy(start.cur, start.last);
-            destroy(finish.first, finish.cur);
-            data_allocator::deallocate(finish.first, _deque_iterator<T, T &, T *, BufSize>::buffer_size());
+            Tiny::destroy(start.cur, start.last);
+            Tiny::destroy(finish.first, finish.cur);
+            data_allocator::deallocate(this->allocator(), finish.first, _deque_iterator<T, T &, T *, BufSize>::buffer_size());
         } else
-            destroy(start.cur, finish.cur);
-        finish = start;
+            Tiny::destroy(start.cur, finish.cur);
+        /**逐个成员赋值：GCC 12 的 modref 会把同一对象内的整体拷贝 finish = start 误判为不修改 *this，
+         * 内联后调用方继续使用 clear 之前的 finish*/
+        finish.set_node(start.node);
+        finish.cur = start.cur;
     }
 
     template<typename T, typename Alloc, size_t BufSize>
@@ -383,10 +447,10 @@ namespace Tiny {
                 std::copy_backward(start.node, finish.node + 1, new_nstart + old_num_nodes);
         } else {
             size_type new_map_size = map_size + std::max(map_size, nodes_to_add) + 2;
-            map_pointer new_map = map_allocator::allocate(new_map_size);
+            map_pointer new_map = map_allocator::allocate(this->allocator(), new_map_size);
             new_nstart = new_map + (new_map_size - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
-            std::copy(start.node, finish.node + 1, new_nstart);
-            map_allocator::deallocate(map, map_size);
+            Tiny::uninitialized_relocate(start.node, finish.node + 1, new_nstart);
+            map_allocator::deallocate(this->allocator(), map, map_size);
             map = new_map;
             map_size = new_map_size;
         }
@@ -402,7 +466,7 @@ namespace Tiny {
         try {
             start.set_node(start.node - 1);
             start.cur = start.last - 1;
-            construct(start.cur, t_copy);
+            construct(start.cur, std::move(t_copy));
         }
         catch (...) {
             start.set_node(start.node + 1);
@@ -428,7 +492,7 @@ namespace Tiny {
         reserve_map_at_back();
         *(finish.node + 1) = allocate_node();
         try {
-            construct(finish.cur, t_copy);
+            construct(finish.cur, std::move(t_copy));
             finish.set_node(finish.node + 1);
             finish.cur = finish.first;
         }
@@ -453,11 +517,16 @@ namespace Tiny {
         map_pointer cur;
         try {
             for (cur = start.node; cur < finish.node; ++cur)
-                uninitialized_fill(*cur, *cur + _deque_iterator<T, T &, T *, BufSize>::buffer_size(), value);
-            uninitialized_fill(finish.first, finish.cur, value);
+                Tiny::uninitialized_fill(*cur, *cur + _deque_iterator<T, T &, T *, BufSize>::buffer_size(), value);
+            Tiny::uninitialized_fill(finish.first, finish.cur, value);
         }
-        catch (...) {
-
+        catch (...) {/**uninitialized_fill 已回滚出错的缓冲区，析构之前填满的缓冲区后释放全部空间*/
+            for (map_pointer node = start.node; node < cur; ++node)
+                Tiny::destroy(*node, *node + _deque_iterator<T, T &, T *, BufSize>::buffer_size());
+            data_allocator::deallocate_batch(this->allocator(), _deque_iterator<T, T &, T *, BufSize>::buffer_size(),
+                                             finish.node - start.node + 1, start.node);
+            map_allocator::deallocate(this->allocator(), map, map_size);
+            throw;
         }
     }
 
@@ -465,15 +534,15 @@ namespace Tiny {
     void deque<T, Alloc, BufSize>::create_map_and_node(deque::size_type num_elements) {
         size_type num_nodes = num_elements / _deque_iterator<T, T &, T *, BufSize>::buffer_size() + 1;
         map_size = std::max(initial_map_size(), num_nodes + 2);
-        map = map_allocator::allocate(map_size);
+        map = map_allocator::allocate(this->allocator(), map_size);
         map_pointer nstart = map + (map_size - num_nodes) / 2;
         map_pointer nfinish = nstart + num_nodes - 1;
-        map_pointer cur;
-        try {
-            for (cur = nstart; cur <= nfinish; ++cur)
-                *cur = allocate_node();
+        try {/**全部缓冲区一次取出；失败时 allocate_batch 已归还取到的缓冲区*/
+            data_allocator::allocate_batch(this->allocator(), _deque_iterator<T, T &, T *, BufSize>::buffer_size(),
+                                           num_nodes, nstart);
         } catch (...) {
-
+            map_allocator::deallocate(this->allocator(), map, map_size);
+            throw;
         }
 
         start.set_node(nstart);
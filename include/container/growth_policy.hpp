@@ -0,0 +1,71 @@
+//
+// Created by guo on 24-11-21.
+//
+
+#ifndef TINY_STL_GROWTH_POLICY_HPP
+#define TINY_STL_GROWTH_POLICY_HPP
+
+#include <cstddef>
+
+namespace Tiny {
+    /**
+     * 扩容策略：static size_t next_capacity(size_t capacity, size_t required, size_t elem_size, size_t max_elems)
+     * 返回容量不足时新的元素个数，须满足 required <= 结果 <= max_elems（调用方保证 required <= max_elems）。
+     * capacity 为当前容量，elem_size 为元素字节数。
+     */
+
+    /**按 Num / Den 倍几何增长，增长量不足时直接取 required*/
+    template<size_t Num, size_t Den>
+    struct growth_factor {
+        static_assert(Num > Den, "growth factor must be greater than 1");
+
+        static size_t next_capacity(size_t capacity, size_t required, size_t /** elem_size */, size_t max_elems) {
+            if (capacity >= max_elems / Num * Den)/**再增长就会超过上限*/
+                return max_elems;
+            /**先除后乘，避免 capacity * Num 溢出*/
+            const size_t grown = capacity / Den * Num + capacity % Den * Num / Den;
+            return grown < required ? required : grown;
+        }
+    };
+
+    typedef growth_factor<2, 1> growth_2x;/**翻倍，摊还拷贝次数最少*/
+    typedef growth_factor<3, 2> growth_1_5x;/**1.5 倍：峰值占用更低，且释放的旧块累计起来可以容纳之后的新块*/
+
+    /**
+     * 按页取整：先按 Base 计算，所需字节数达到 PageSize 后向上取整到 PageSize 的倍数，并把整页都计入容量。
+     * 大块内存由系统按页映射，取整部分本来就已分配，计入容量可以推迟下一次扩容。
+     */
+    template<typename Base = growth_1_5x, size_t PageSize = 4096>
+    struct page_growth {
+        static_assert((PageSize & (PageSize - 1)) == 0, "page size must be a power of 2");
+
+        static size_t next_capacity(size_t capacity, size_t required, size_t elem_size, size_t max_elems) {
+            const size_t n = Base::next_capacity(capacity, required, elem_size, max_elems);
+            if (n > static_cast<size_t>(-1) / elem_size || n * elem_size < PageSize)
+                return n;
+            const size_t bytes = n * elem_size;
+            const size_t rounded = (bytes + PageSize - 1) & ~(PageSize - 1);
+            if (rounded < bytes)/**取整溢出*/
+                return n;
+            const size_t elems = rounded / elem_size;
+            return elems > max_elems ? max_elems : elems;
+        }
+    };
+
+    /**
+     * 大页取整：不足 2 MiB 时按普通页取整，达到后按 2 MiB 取整，与透明大页的粒度一致
+     */
+    template<typename Base = growth_1_5x>
+    struct huge_page_growth {
+        static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+        static size_t next_capacity(size_t capacity, size_t required, size_t elem_size, size_t max_elems) {
+            const size_t n = page_growth<Base>::next_capacity(capacity, required, elem_size, max_elems);
+            if (n * elem_size < HUGE_PAGE_SIZE)
+                return n;
+            return page_growth<Base, HUGE_PAGE_SIZE>::next_capacity(capacity, required, elem_size, max_elems);
+        }
+    };
+}
+
+#endif //TINY_STL_GROWTH_POLICY_HPP
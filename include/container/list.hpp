@@ -5,6 +5,7 @@
 #ifndef TINY_STL_LIST_HPP
 #define TINY_STL_LIST_HPP
 
+#include <iterator>
 #include "../allocator/allocator.hpp"
 
 
@@ -42,6 +43,8 @@ namespace Tiny {
 
         _list_iterator(const iterator &x) : node(x.node) {}
 
+        _list_iterator &operator=(const _list_iterator &) = default;
+
         /**运算符重载*/
         bool operator==(const self &x) const { return node == x.node; }
 
@@ -75,7 +78,7 @@ namespace Tiny {
     };
 
     template<typename T, typename Alloc=alloc>
-    class list {
+    class list : protected alloc_base<Alloc> {
         /**基本数据重命名*/
     public:
         typedef T value_type;
@@ -83,6 +86,9 @@ namespace Tiny {
         typedef value_type &reference;
         typedef const value_type &const_reference;
         typedef value_type *pointer;
+        typedef Alloc allocator_type;
+
+        using alloc_base<Alloc>::get_allocator;
     protected:
         typedef _list_node<value_type> list_node;
         typedef simple_alloc<list_node, Alloc> list_node_allocator;
@@ -93,21 +99,46 @@ namespace Tiny {
     protected:
         link_type node;
 
-        link_type get_node() { return list_node_allocator::allocate(); };
+        /**批量分配与释放节点时每批的节点数*/
+        static constexpr size_type NODE_BATCH = 64;
 
-        void put_node(link_type p) { list_node_allocator::deallocate(p); }
+        link_type get_node() { return list_node_allocator::allocate(this->allocator()); };
 
-        link_type create_node(const T &x) {
+        void put_node(link_type p) { list_node_allocator::deallocate(this->allocator(), p); }
+
+        /**分配节点并以 x 构造其中的元素，右值实参移动构造*/
+        template<typename U>
+        link_type create_node(U &&x) {
             link_type result = get_node();
-            construct(&result->data, x);
+            try {
+                construct(&result->data, std::forward<U>(x));
+            }
+            catch (...) {
+                put_node(result);
+                throw;
+            }
             return result;
         }
 
+        /**把新节点挂到 position 之前*/
+        static iterator link_before(iterator position, link_type temp) {
+            temp->next = position.node;
+            temp->prev = position.node->prev;
+            (static_cast<link_type>(position.node->prev))->next = temp;
+            position.node->prev = temp;
+            return temp;
+        }
+
         void destroy_node(link_type p) {
             destroy(&p->data);
             put_node(p);
         }
 
+        /**在 position 之前插入 n 个节点：节点按批从分配器整段取出，元素由 init(p) 依次构造；
+         * 任一步抛出异常时撤销本次插入的全部节点。返回第一个新节点*/
+        template<typename Init>
+        iterator insert_nodes(iterator position, size_type n, Init init);
+
         void empty_initialize() {
             node = get_node();
             node->prev = node;
@@ -121,7 +152,7 @@ namespace Tiny {
                 (static_cast<link_type>((*last.node).prev))->next = position.node;
                 (static_cast<link_type>((*first.node).prev))->next = last.node;
                 (static_cast<link_type>((*position.node).prev))->next = first.node;
-                link_type temp = static_cast<link_type >(*position.node)->prev;
+                link_type temp = static_cast<link_type>(position.node->prev);
                 position.node->prev = last.node->prev;
                 last.node->prev = first.node->prev;
                 first.node->prev = temp;
@@ -132,6 +163,59 @@ namespace Tiny {
     public:
         list() { empty_initialize(); }
 
+        /**使用指定的分配器实例*/
+        explicit list(const Alloc &a) : alloc_base<Alloc>(a) { empty_initialize(); }
+
+        list(size_type n, const T &value, const Alloc &a = Alloc()) : alloc_base<Alloc>(a) {
+            empty_initialize();
+            try {
+                insert(end(), n, value);
+            }
+            catch (...) {
+                put_node(node);
+                throw;
+            }
+        }
+
+        list(int n, const T &value, const Alloc &a = Alloc()) : list(static_cast<size_type>(n), value, a) {}
+
+        list(long n, const T &value, const Alloc &a = Alloc()) : list(static_cast<size_type>(n), value, a) {}
+
+        template<typename InputIterator, typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
+        list(InputIterator first, InputIterator last, const Alloc &a = Alloc()) : alloc_base<Alloc>(a) {
+            empty_initialize();
+            try {
+                insert(end(), first, last);
+            }
+            catch (...) {
+                put_node(node);
+                throw;
+            }
+        }
+
+        list(const list &x) : list(x.begin(), x.end(), x.get_allocator()) {}
+
+        /**接管 x 的节点，x 变为空链表（另配一个哨兵节点）*/
+        list(list &&x) : alloc_base<Alloc>(x.get_allocator()) {
+            empty_initialize();
+            std::swap(node, x.node);
+        }
+
+        ~list() {
+            clear();
+            put_node(node);
+        }
+
+        list &operator=(const list &x);
+
+        /**分配器相同时交换节点，否则逐个移动元素；之后 x 为空*/
+        list &operator=(list &&x);
+
+        void swap(list &x) noexcept {
+            std::swap(static_cast<alloc_base<Alloc> &>(*this), static_cast<alloc_base<Alloc> &>(x));
+            std::swap(node, x.node);
+        }
+
 
         iterator begin() { return static_cast<link_type >(node->next); }
 
@@ -145,17 +229,44 @@ namespace Tiny {
 
         size_type size() const {
             size_type result = 0;
-            result = distance(begin(), end());
+            result = Tiny::distance(begin(), end());
             return result;
         }
 
-        iterator insert(iterator position, const T &x) {
-            link_type temp = create_node(x);
-            temp->next = position.node;
-            temp->prev = position.node->prev;
-            (static_cast<link_type>(position.node->prev))->next = temp;
-            position.node->prev = temp;
-            return temp;
+        iterator insert(iterator position, const T &x) { return link_before(position, create_node(x)); }
+
+        /**移动构造新元素*/
+        iterator insert(iterator position, T &&x) { return link_before(position, create_node(std::move(x))); }
+
+        /**在 position 之前插入 n 个 x，节点按批分配*/
+        iterator insert(iterator position, size_type n, const T &x) {
+            return insert_nodes(position, n, [&x](T *p) { Tiny::construct(p, x); });
+        }
+
+        /**在 position 之前插入 [first, last)，前向迭代器先求出长度后按批分配节点*/
+        template<typename InputIterator, typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
+        iterator insert(iterator position, InputIterator first, InputIterator last) {
+            typedef typename std::iterator_traits<InputIterator>::iterator_category category;
+            if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value ||
+                          std::is_base_of<forward_iterator_tag, category>::value) {
+                const auto n = static_cast<size_type>(std::distance(first, last));
+                return insert_nodes(position, n, [&first](T *p) {
+                    Tiny::construct(p, *first);
+                    ++first;
+                });
+            } else {
+                link_type prev = static_cast<link_type>(position.node->prev);
+                try {
+                    for (; first != last; ++first)
+                        insert(position, *first);
+                }
+                catch (...) {
+                    while (prev->next != position.node)
+                        erase(iterator(static_cast<link_type>(prev->next)));
+                    throw;
+                }
+                return iterator(static_cast<link_type>(prev->next));
+            }
         }
 
         reference front() { return *begin(); }
@@ -164,8 +275,12 @@ namespace Tiny {
 
         void push_front(const T &x) { insert(begin(), x); }
 
+        void push_front(T &&x) { insert(begin(), std::move(x)); }
+
         void push_back(const T &x) { insert(end(), x); }
 
+        void push_back(T &&x) { insert(end(), std::move(x)); }
+
         iterator erase(iterator position) {
             link_type next_node = static_cast<link_type >(position.node->next);
             link_type prev_node = static_cast<link_type >(position.node->prev);
@@ -202,6 +317,75 @@ namespace Tiny {
 
     };
 
+    template<typename T, typename Alloc>
+    template<typename Init>
+    typename list<T, Alloc>::iterator list<T, Alloc>::insert_nodes(iterator position, size_type n, Init init) {
+        link_type prev = static_cast<link_type>(position.node->prev);
+        link_type batch[NODE_BATCH];
+        size_type count = 0;
+        size_type k = 0;/**batch 中尚未挂入链表的节点从 k 开始*/
+        try {
+            while (n != 0) {
+                count = std::min(n, NODE_BATCH);
+                k = count;
+                list_node_allocator::allocate_batch(this->allocator(), 1, count, batch);
+                for (k = 0; k < count; ++k) {
+                    init(&batch[k]->data);
+                    link_before(position, batch[k]);
+                }
+                n -= count;
+            }
+        }
+        catch (...) {
+            if (k < count)
+                list_node_allocator::deallocate_batch(this->allocator(), 1, count - k, batch + k);
+            while (prev->next != position.node)
+                erase(iterator(static_cast<link_type>(prev->next)));
+            throw;
+        }
+        return iterator(static_cast<link_type>(prev->next));
+    }
+
+    template<typename T, typename Alloc>
+    list<T, Alloc> &list<T, Alloc>::operator=(const list &x) {
+        if (this != &x) {/**已有节点直接赋值，多余的删除，不足的追加*/
+            iterator first1 = begin();
+            iterator last1 = end();
+            iterator first2 = x.begin();
+            iterator last2 = x.end();
+            for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+                *first1 = *first2;
+            if (first2 == last2) {
+                while (first1 != last1)
+                    first1 = erase(first1);
+            } else {
+                insert(last1, first2, last2);
+            }
+        }
+        return *this;
+    }
+
+    template<typename T, typename Alloc>
+    list<T, Alloc> &list<T, Alloc>::operator=(list &&x) {
+        if (this == &x)
+            return *this;
+        clear();
+        bool same = true;
+        if constexpr (!std::is_empty<Alloc>::value)
+            same = this->allocator() == x.allocator();
+        if (same) {
+            std::swap(node, x.node);
+        } else {/**x 的节点只能由它自己的分配器释放*/
+            for (iterator i = x.begin(); i != x.end(); ++i)
+                push_back(std::move(*i));
+            x.clear();
+        }
+        return *this;
+    }
+
+    template<typename T, typename Alloc>
+    void swap(list<T, Alloc> &x, list<T, Alloc> &y) noexcept { x.swap(y); }
+
     template<typename T, typename Alloc>
     void list<T, Alloc>::sort() {
         if (node->next == node || static_cast<link_type>(node->next)->next == node)
@@ -293,11 +477,19 @@ namespace Tiny {
     template<typename T, typename Alloc>
     void list<T, Alloc>::clear() {
         link_type cur = static_cast<link_type >(node->next);
+        link_type batch[NODE_BATCH];
+        size_type count = 0;
         while (cur != node) {
             link_type temp = cur;
             cur = static_cast<link_type >(cur->next);
-            destroy_node(temp);
+            Tiny::destroy(&temp->data);
+            batch[count++] = temp;
+            if (count == NODE_BATCH) {/**攒满一批后整段归还分配器*/
+                list_node_allocator::deallocate_batch(this->allocator(), 1, count, batch);
+                count = 0;
+            }
         }
+        list_node_allocator::deallocate_batch(this->allocator(), 1, count, batch);
         node->next = node;
         node->prev = node;
     }
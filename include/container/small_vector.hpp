@@ -0,0 +1,21 @@
+//
+// Created by guo on 24-11-21.
+//
+
+#ifndef TINY_STL_SMALL_VECTOR_HPP
+#define TINY_STL_SMALL_VECTOR_HPP
+
+#include "vector.hpp"
+
+namespace Tiny {
+    /**
+     * 带内嵌缓冲区的 vector：不超过 N 个元素时存放在对象内部，构造、插入都不经过分配器；
+     * 超过 N 个后按 Growth 扩容到分配器的空间，之后与 vector 完全相同。
+     * 扩容、搬迁与异常安全的实现都与 vector 共用，只是多了一块 N 个元素的内嵌存储。
+     * 注意移动与交换在元素位于内嵌缓冲区时需要逐个移动，迭代器随之失效。
+     */
+    template<typename T, size_t N, typename Alloc=alloc, typename Growth=growth_2x>
+    using small_vector = vector<T, Alloc, Growth, N>;
+}
+
+#endif //TINY_STL_SMALL_VECTOR_HPP
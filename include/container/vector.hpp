@@ -5,19 +5,55 @@
 #ifndef TINY_STL_VECTOR_HPP
 #define TINY_STL_VECTOR_HPP
 
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
 #include "../allocator/allocator.hpp"
+#include "growth_policy.hpp"
 
 namespace Tiny {
 
-    template<typename T, typename Alloc=alloc>
-    class vector {
+    /**容器内嵌的未初始化缓冲区，可存放 N 个元素*/
+    template<typename T, size_t N>
+    class vector_buffer {
+    protected:
+        T *buffer() { return reinterpret_cast<T *>(storage); }
+
+        const T *buffer() const { return reinterpret_cast<const T *>(storage); }
+
+    private:
+        alignas(T) unsigned char storage[N * sizeof(T)];
+    };
+
+    /**N 为 0 时不占空间*/
+    template<typename T>
+    class vector_buffer<T, 0> {
+    protected:
+        T *buffer() { return nullptr; }
+
+        const T *buffer() const { return nullptr; }
+    };
+
+    /**
+     * Growth 为扩容策略（见 growth_policy.hpp），默认翻倍。
+     * N 为内嵌容量：不超过 N 个元素时存放在对象内部而不经过分配器，超过后整体搬到分配器的空间（见 small_vector.hpp）。
+     */
+    template<typename T, typename Alloc=alloc, typename Growth=growth_2x, size_t N=0>
+    class vector : protected alloc_base<Alloc>, protected vector_buffer<T, N> {
     public:
         typedef T value_type;
         typedef value_type *pointer;
         typedef value_type *iterator;
+        typedef const value_type *const_iterator;
         typedef value_type &reference;
+        typedef const value_type &const_reference;
         typedef size_t size_type;
         typedef ptrdiff_t difference_type;
+        typedef Alloc allocator_type;
+        typedef Growth growth_policy;
+        static constexpr size_type inline_capacity = N;
+
+        using alloc_base<Alloc>::get_allocator;
 
     protected:
         typedef simple_alloc<value_type, Alloc> data_allocator;
@@ -26,24 +62,197 @@ namespace Tiny {
         iterator end_of_storage;
 
 
-        void insert_aux(iterator position, const T &x);
+        /**可按字节搬迁的元素，扩容时交给分配器的 reallocate，省去逐个拷贝与析构*/
+        static constexpr bool relocatable = is_trivially_relocatable<T>::value;
+
+        /**p 是否为内嵌缓冲区*/
+        bool is_inline(const T *p) const {
+            if constexpr (N == 0)
+                return false;
+            else
+                return p == this->buffer();
+        }
+
+        /**取得 len 个元素的空间：不超过内嵌容量时使用内嵌缓冲区（调用方保证它此时未被占用），否则向分配器申请*/
+        iterator allocate_storage(size_type len) {
+            if constexpr (N != 0) {
+                if (len <= N)
+                    return this->buffer();
+            }
+            return data_allocator::allocate(this->allocator(), len);
+        }
+
+        /**归还 allocate_storage 取得的空间，内嵌缓冲区无需归还*/
+        void release_storage(iterator p, size_type len) {
+            if (!is_inline(p))
+                data_allocator::deallocate(this->allocator(), p, len);
+        }
+
+        /**以 p 起始、申请了 len 个元素的空间的末尾；内嵌缓冲区总是 N 个*/
+        iterator storage_end(iterator p, size_type len) const { return is_inline(p) ? p + N : p + len; }
+
+        /**置为不持有元素的初始状态：使用内嵌缓冲区（N 为 0 时为空指针），不归还原有空间*/
+        void reset_storage() {
+            start = finish = this->buffer();
+            end_of_storage = start + N;
+        }
+
+        /**接管 x 的元素，之后 x 为空；调用前本容器须为空且不持有分配器的空间。
+         * x 使用内嵌缓冲区时逐个移动元素，否则直接接管其空间*/
+        void take(vector &x) {
+            if (x.is_inline(x.start)) {
+                finish = Tiny::uninitialized_move(x.start, x.finish, start);
+                Tiny::destroy(x.start, x.finish);
+                x.finish = x.start;
+            } else {
+                start = x.start;
+                finish = x.finish;
+                end_of_storage = x.end_of_storage;
+                x.reset_storage();
+            }
+        }
+
+        /**再容纳 n 个元素所需的新容量：由 Growth 计算，再把分配器实际给出的块中多余的部分一并计入容量*/
+        size_type recommend(size_type n) const {
+            const size_type max = max_size();
+            if (n > max - size())
+                throw std::length_error("vector");
+            const size_type len = Growth::next_capacity(capacity(), size() + n, sizeof(T), max);
+            const size_type granted = data_allocator::good_size(this->allocator(), len);
+            return granted > max ? len : granted;
+        }
+
+        /**在 position 处以 args 构造一个新元素，必要时扩容；args 可以引用容器自身的元素*/
+        template<typename... Args>
+        void insert_aux(iterator position, Args &&... args);
+
+        /**扩容到 len 并在 position 处插入 n 个元素：先由 construct_new(p) 在新空间的 [p, p + n) 构造新元素
+         * （失败时自行销毁已构造的部分），再按 move_if_noexcept 搬迁原有元素，任何一步抛出异常时原有空间保持不变*/
+        template<typename Construct>
+        void reallocate_insert(iterator position, size_type n, size_type len, Construct construct_new);
+
+        /**把容量换成 len（不小于 size()）：新空间中按 move_if_noexcept 搬迁元素，抛出异常时原有空间保持不变*/
+        void reallocate_move(size_type len) {
+            if constexpr (relocatable) {
+                reallocate_storage(len);
+            } else {
+                iterator new_start = allocate_storage(len);
+                iterator new_finish;
+                try {
+                    new_finish = Tiny::uninitialized_move_if_noexcept(start, finish, new_start);
+                }
+                catch (...) {
+                    release_storage(new_start, len);
+                    throw;
+                }
+                Tiny::destroy(start, finish);
+                deallocate();
+                start = new_start;
+                finish = new_finish;
+                end_of_storage = storage_end(new_start, len);
+            }
+        }
+
+        /**把容量调整为 len，原有元素按字节搬迁；仅用于 relocatable 类型*/
+        void reallocate_storage(size_type len) {
+            const size_type old_size = size();
+            if (is_inline(start) || (N != 0 && len <= N)) {/**进出内嵌缓冲区时分配器无法就地调整，改为申请、拷贝、归还*/
+                iterator new_start = allocate_storage(len);
+                std::memcpy(static_cast<void *>(new_start), start, old_size * sizeof(T));
+                deallocate();
+                start = new_start;
+            } else {
+                start = data_allocator::reallocate(this->allocator(), start, capacity(), len);
+            }
+            finish = start + old_size;
+            end_of_storage = storage_end(start, len);
+        }
+
+        /**在 position 处腾出 n 个未初始化的位置，需要时先扩容到 len；仅用于 relocatable 类型，返回新的插入点*/
+        iterator relocate_gap(iterator position, size_type n, size_type len) {
+            const size_type offset = position - start;
+            const size_type elems_after = finish - position;
+            if (static_cast<size_type>(end_of_storage - finish) < n)
+                reallocate_storage(len);
+            position = start + offset;
+            std::memmove(static_cast<void *>(position + n), position, elems_after * sizeof(T));
+            finish += n;
+            return position;
+        }
 
         void deallocate() {
             if (start)
-                data_allocator::deallocate(start, end_of_storage - start);
+                release_storage(start, end_of_storage - start);
+        }
+
+        /**配置 n 个元素的空间并复制 [first, last)*/
+        template<typename ForwardIterator>
+        iterator allocate_and_copy(size_type n, ForwardIterator first, ForwardIterator last) {
+            iterator result = allocate_storage(n);
+            try {
+                Tiny::uninitialized_copy(first, last, result);
+            }
+            catch (...) {
+                release_storage(result, n);
+                throw;
+            }
+            return result;
+        }
+
+        /**两个容器的分配器能否互相释放对方的内存：无状态分配器总是可以，有状态的按 operator== 判断*/
+        bool same_allocator(const vector &x) const {
+            if constexpr (std::is_empty<Alloc>::value)
+                return true;
+            else
+                return this->allocator() == x.allocator();
         }
 
         /**配置空间并填满内容*/
         iterator alloc_and_fill(size_type n, const T &value) {
-            iterator result = data_allocator::allocate(n);
-            uninitialized_fill_n(result, n, value);
+            iterator result = allocate_storage(n);
+            try {
+                Tiny::uninitialized_fill_n(result, n, value);
+            }
+            catch (...) {
+                release_storage(result, n);
+                throw;
+            }
             return result;
         }
 
+        /**前向迭代器区间的长度，随机访问迭代器直接相减*/
+        template<typename ForwardIterator>
+        static size_type range_length(ForwardIterator first, ForwardIterator last) {
+            if constexpr (is_random_access_iterator<ForwardIterator>) {
+                return static_cast<size_type>(last - first);
+            } else {
+                size_type n = 0;
+                for (; first != last; ++first)
+                    ++n;
+                return n;
+            }
+        }
+
+        /**返回 first 前进 n 步后的迭代器*/
+        template<typename ForwardIterator>
+        static ForwardIterator range_advance(ForwardIterator first, size_type n) {
+            if constexpr (is_random_access_iterator<ForwardIterator>) {
+                return first + n;
+            } else {
+                for (; n != 0; --n)
+                    ++first;
+                return first;
+            }
+        }
+
+        /**在 position 处插入长度为 n（非零）的前向迭代器区间，备用空间不足时只扩容一次*/
+        template<typename ForwardIterator>
+        void range_insert(iterator position, ForwardIterator first, ForwardIterator last, size_type n);
+
         void fill_initialize(size_type n, const T &value) {
             start = alloc_and_fill(n, value);
             finish = start + n;
-            end_of_storage = finish;
+            end_of_storage = storage_end(start, n);
         }
 
     public:
@@ -61,36 +270,150 @@ namespace Tiny {
 
         bool empty() const { return begin() == end(); }
 
+        size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
+
         reference operator[](size_type n) { return *(begin() + n); }
 
-        vector() : start(nullptr), finish(nullptr), end_of_storage(nullptr) {}
+        const_reference operator[](size_type n) const { return *(begin() + n); }
 
-        vector(size_type n, const T &value) { fill_initialize(n, value); }
+        vector() : start(this->buffer()), finish(start), end_of_storage(start + N) {}
 
-        vector(int n, const T &value) { fill_initialize(n, value); }
+        /**使用指定的分配器实例*/
+        explicit vector(const Alloc &a) : alloc_base<Alloc>(a), start(this->buffer()), finish(start),
+                                          end_of_storage(start + N) {}
 
-        vector(long n, const T &value) { fill_initialize(n, value); }
+        vector(size_type n, const T &value, const Alloc &a = Alloc()) : alloc_base<Alloc>(a) {
+            fill_initialize(n, value);
+        }
+
+        vector(int n, const T &value, const Alloc &a = Alloc()) : alloc_base<Alloc>(a) { fill_initialize(n, value); }
+
+        vector(long n, const T &value, const Alloc &a = Alloc()) : alloc_base<Alloc>(a) { fill_initialize(n, value); }
 
-        explicit vector(size_type n) { fill_initialize(n, T()); }
+        explicit vector(size_type n, const Alloc &a = Alloc()) : alloc_base<Alloc>(a) { fill_initialize(n, T()); }
+
+        /**以 [first, last) 构造：前向迭代器先求出长度，只分配一次；输入迭代器逐个追加*/
+        template<typename InputIterator, typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
+        vector(InputIterator first, InputIterator last, const Alloc &a = Alloc())
+                : alloc_base<Alloc>(a), start(this->buffer()), finish(start), end_of_storage(start + N) {
+            if constexpr (is_forward_iterator<InputIterator>) {
+                const size_type n = range_length(first, last);
+                start = allocate_and_copy(n, first, last);
+                finish = start + n;
+                end_of_storage = storage_end(start, n);
+            } else {
+                try {
+                    for (; first != last; ++first)
+                        emplace_back(*first);
+                }
+                catch (...) {
+                    Tiny::destroy(start, finish);
+                    deallocate();
+                    throw;
+                }
+            }
+        }
+
+        vector(std::initializer_list<T> il, const Alloc &a = Alloc()) : vector(il.begin(), il.end(), a) {}
+
+        vector(const vector &x) : alloc_base<Alloc>(x.get_allocator()) {
+            start = allocate_and_copy(x.size(), x.begin(), x.end());
+            finish = start + x.size();
+            end_of_storage = storage_end(start, x.size());
+        }
+
+        /**接管 x 的空间，x 变为空；x 的元素在内嵌缓冲区中时逐个移动*/
+        vector(vector &&x) noexcept(N == 0 || std::is_nothrow_move_constructible<T>::value)
+                : alloc_base<Alloc>(x.get_allocator()), start(this->buffer()), finish(start),
+                  end_of_storage(start + N) {
+            take(x);
+        }
 
         ~vector() {
-            destroy(start, finish);
+            Tiny::destroy(start, finish);
             deallocate();
         }
 
+        vector &operator=(const vector &x);
+
+        vector &operator=(std::initializer_list<T> il) {
+            assign(il.begin(), il.end());
+            return *this;
+        }
+
+        /**分配器相同时接管 x 的空间，否则逐个移动元素；之后 x 为空*/
+        vector &operator=(vector &&x) noexcept(std::is_empty<Alloc>::value &&
+                                               (N == 0 || std::is_nothrow_move_constructible<T>::value));
+
+        /**双方都不在内嵌缓冲区时只交换指针，否则借助临时容器移动元素*/
+        void swap(vector &x) noexcept(N == 0 || std::is_nothrow_move_constructible<T>::value) {
+            if (!is_inline(start) && !x.is_inline(x.start)) {
+                std::swap(start, x.start);
+                std::swap(finish, x.finish);
+                std::swap(end_of_storage, x.end_of_storage);
+            } else {
+                vector tmp(std::move(x));
+                x.take(*this);
+                take(tmp);
+            }
+            std::swap(static_cast<alloc_base<Alloc> &>(*this), static_cast<alloc_base<Alloc> &>(x));
+        }
+
         reference front() { return *begin(); }
 
         reference back() { return *(end() - 1); }
 
-        void push_back(const T &x) {
+        /**容量至少为 n；扩容时元素按 move_if_noexcept 搬迁，抛出异常时容器保持不变*/
+        void reserve(size_type n) {
+            if (n > capacity())
+                reallocate_move(n);
+        }
+
+        /**把容量收缩到 size()，空容器释放全部空间，放得进内嵌缓冲区时搬回；抛出异常时容器保持不变*/
+        void shrink_to_fit() {
+            if (finish == end_of_storage || is_inline(start))
+                return;
+            if (empty()) {
+                deallocate();
+                reset_storage();
+            } else {
+                reallocate_move(size());
+            }
+        }
+
+        void push_back(const T &x) { emplace_back(x); }
+
+        void push_back(T &&x) { emplace_back(std::move(x)); }
+
+        /**在末尾以 args 直接构造元素；扩容时若构造抛出异常，容器保持不变*/
+        template<typename... Args>
+        reference emplace_back(Args &&... args) {
             if (finish != end_of_storage) {
-                construct(finish, x);
+                construct(finish, std::forward<Args>(args)...);
+                ++finish;
+            } else {
+                insert_aux(end(), std::forward<Args>(args)...);
+            }
+            return back();
+        }
+
+        /**在 position 之前以 args 直接构造元素，返回指向新元素的迭代器*/
+        template<typename... Args>
+        iterator emplace(iterator position, Args &&... args) {
+            const size_type offset = position - start;
+            if (position == finish && finish != end_of_storage) {
+                construct(finish, std::forward<Args>(args)...);
                 ++finish;
             } else {
-                insert_aux(end(), x);
+                insert_aux(position, std::forward<Args>(args)...);
             }
+            return start + offset;
         }
 
+        iterator insert(iterator position, const T &x) { return emplace(position, x); }
+
+        iterator insert(iterator position, T &&x) { return emplace(position, std::move(x)); }
+
         void pop_back() {
             --finish;
             destroy(finish);
@@ -98,15 +421,15 @@ namespace Tiny {
 
         iterator erase(iterator position) {
             if (position + 1 != end())
-                std::copy(position + 1, finish, position);
+                std::move(position + 1, finish, position);
             --finish;
             destroy(finish);
             return position;
         }
 
         iterator erase(iterator first, iterator last) {
-            iterator i = std::copy(last, finish, first);
-            destroy(i, finish);
+            iterator i = std::move(last, finish, first);
+            Tiny::destroy(i, finish);
             finish -= last - first;
             return first;
         }
@@ -120,87 +443,297 @@ namespace Tiny {
 
         void resize(size_type new_size) { resize(new_size, T()); }
 
+        /**把大小调整为 new_size，新增元素默认初始化而不是值初始化：可平凡默认构造的类型（如 uint8_t）
+         * 不写入任何内容，值未定，适合随即整体覆盖的缓冲区；扩容按 Growth 进行*/
+        void resize_default_init(size_type new_size) {
+            if (new_size <= size()) {
+                erase(begin() + new_size, end());
+                return;
+            }
+            if (new_size > capacity())
+                reallocate_move(recommend(new_size - size()));
+            Tiny::uninitialized_default_construct(finish, start + new_size);
+            finish = start + new_size;
+        }
+
+        /**在末尾备好至少 n 个元素的空间（需要时按 Growth 扩容），以 writer(p, n) 直接写入未初始化的 [p, p + n)，
+         * writer 返回实际写入的个数（须在 [0, n] 之内），只有这些元素计入 size()，并作为本函数的返回值。
+         * 仅用于可平凡默认构造且可平凡析构的类型；writer 抛出异常时大小不变（容量可能已经增加）*/
+        template<typename Writer>
+        size_type reserve_and_write(size_type n, Writer writer) {
+            static_assert(std::is_trivially_default_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                          "reserve_and_write requires a trivially constructible and destructible type");
+            if (static_cast<size_type>(end_of_storage - finish) < n)
+                reallocate_move(recommend(n));
+            const size_type written = static_cast<size_type>(writer(finish, n));
+            finish += written;
+            return written;
+        }
+
         void clear() { erase(begin(), end()); }
 
         void insert(iterator position, size_type n, const T &x);
 
+        /**在 position 之前插入 [first, last)，返回指向第一个插入元素的迭代器。
+         * 前向迭代器先求出长度，备用空间不足时只扩容一次；可按字节搬迁的类型以 memmove 腾出空位。
+         * 输入迭代器先逐个追加到末尾，再整体旋转到 position*/
+        template<typename InputIterator, typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
+        iterator insert(iterator position, InputIterator first, InputIterator last);
+
+        iterator insert(iterator position, std::initializer_list<T> il) {
+            return insert(position, il.begin(), il.end());
+        }
+
+        /**把 rg 中的元素追加到末尾，等同于 insert(end(), begin(rg), end(rg))*/
+        template<typename Range>
+        void append_range(Range &&rg) {
+            using std::begin;
+            using std::end;
+            insert(this->end(), begin(rg), end(rg));
+        }
+
+        /**内容替换为 n 个 x*/
+        void assign(size_type n, const T &x);
+
+        /**内容替换为 [first, last)，已有元素直接赋值，空间不足时只分配一次*/
+        template<typename InputIterator, typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
+        void assign(InputIterator first, InputIterator last);
+
+        void assign(std::initializer_list<T> il) { assign(il.begin(), il.end()); }
+
 
     };
 
-    template<typename T, typename Alloc>
-    void vector<T, Alloc>::insert(vector::iterator position, vector::size_type n, const T &x) {
+    template<typename T, typename Alloc, typename Growth, size_t N>
+    void vector<T, Alloc, Growth, N>::insert(vector::iterator position, vector::size_type n, const T &x) {
         if (n != 0) {
-            if (static_cast<size_type>(end_of_storage - finish) >= n) {/**备用空间大于等于新增元素个数*/
+            /**尚无存储时直接走下面的分配路径，空指针区间不会进入 move_backward/fill*/
+            if (nullptr != start && static_cast<size_type>(end_of_storage - finish) >= n) {/**备用空间大于等于新增元素个数*/
                 T x_copy = x;
                 const size_type elems_after = finish - position;
                 iterator old_finish = finish;
-                if (elems_after > n) {/**插入点之后的现有元素个数大于新增元素个数*/
-                    uninitialized_copy(finish - n, finish, finish);
+                if (0 == elems_after) {/**在尾部插入：只需在备用空间中构造*/
+                    Tiny::uninitialized_fill_n(finish, n, x_copy);
+                    finish += n;
+                } else if (elems_after > n) {/**插入点之后的现有元素个数大于新增元素个数*/
+                    Tiny::uninitialized_move(finish - n, finish, finish);
                     finish += n;
-                    std::copy_backward(position, old_finish - n, old_finish);
+                    std::move_backward(position, old_finish - n, old_finish);
                     std::fill(position, position + n, x_copy);
                 } else {/**插入点之后的现有元素个数小于等于新增元素个数*/
-                    uninitialized_fill_n(finish, n - elems_after, x_copy);
+                    Tiny::uninitialized_fill_n(finish, n - elems_after, x_copy);
                     finish += n - elems_after;
-                    uninitialized_copy(position, old_finish, finish);
+                    Tiny::uninitialized_move(position, old_finish, finish);
                     finish += elems_after;
                     std::fill(position, old_finish, x_copy);
                 }
+            } else if constexpr (relocatable && std::is_nothrow_copy_constructible<T>::value) {
+                /**备用空间不足，可按字节搬迁：原地扩展或由分配器搬迁；填充不会抛出，空位不会残留在 [start, finish) 中*/
+                const T x_copy = x;
+                position = relocate_gap(position, n, recommend(n));
+                Tiny::uninitialized_fill_n(position, n, x_copy);
             } else {/**备用空间小于新增元素个数*/
-                const size_type old_size = size();
-                const size_type len = old_size + std::max(old_size, n);
-                iterator new_start = data_allocator::allocate(len);
-                iterator new_finish = new_start;
-                try {
-                    new_finish = uninitialized_copy(start, position, new_start);
-                    new_finish = uninitialized_fill_n(new_finish, n, x);
-                    new_finish = uninitialized_copy(position, finish, new_finish);
-                }
-                catch (...) {
-                    destroy(new_start, new_finish);
-                    data_allocator::deallocate(new_start, len);
-                    throw;
-                }
-                destroy(start, finish);
+                reallocate_insert(position, n, recommend(n),
+                                  [n, &x](iterator p) { Tiny::uninitialized_fill_n(p, n, x); });
+            }
+        }
+    }
+
+    template<typename T, typename Alloc, typename Growth, size_t N>
+    template<typename ForwardIterator>
+    void vector<T, Alloc, Growth, N>::range_insert(vector::iterator position, ForwardIterator first,
+                                                   ForwardIterator last, vector::size_type n) {
+        typedef typename std::iterator_traits<ForwardIterator>::reference source_reference;
+        if constexpr (relocatable && std::is_nothrow_constructible<T, source_reference>::value) {
+            /**构造不会抛出：memmove 腾出空位（需要时由分配器扩容）后直接构造，空位不会残留*/
+            const size_type len = static_cast<size_type>(end_of_storage - finish) >= n ? capacity() : recommend(n);
+            position = relocate_gap(position, n, len);
+            Tiny::uninitialized_copy(first, last, position);
+        } else if (static_cast<size_type>(end_of_storage - finish) >= n) {
+            const size_type elems_after = finish - position;
+            iterator old_finish = finish;
+            if (elems_after > n) {
+                Tiny::uninitialized_move(finish - n, finish, finish);
+                finish += n;
+                std::move_backward(position, old_finish - n, old_finish);
+                std::copy(first, last, position);
+            } else {
+                ForwardIterator mid = range_advance(first, elems_after);
+                Tiny::uninitialized_copy(mid, last, finish);
+                finish += n - elems_after;
+                Tiny::uninitialized_move(position, old_finish, finish);
+                finish += elems_after;
+                std::copy(first, mid, position);
+            }
+        } else {
+            reallocate_insert(position, n, recommend(n),
+                              [&first, &last](iterator p) { Tiny::uninitialized_copy(first, last, p); });
+        }
+    }
+
+    template<typename T, typename Alloc, typename Growth, size_t N>
+    template<typename InputIterator, typename>
+    typename vector<T, Alloc, Growth, N>::iterator
+    vector<T, Alloc, Growth, N>::insert(vector::iterator position, InputIterator first, InputIterator last) {
+        const size_type offset = position - start;
+        if constexpr (is_forward_iterator<InputIterator>) {
+            const size_type n = range_length(first, last);
+            if (n != 0)
+                range_insert(position, first, last, n);
+        } else {/**单趟区间长度未知：追加到末尾后旋转，整体仍为线性时间*/
+            const size_type old_size = size();
+            for (; first != last; ++first)
+                emplace_back(*first);
+            std::rotate(start + offset, start + old_size, finish);
+        }
+        return start + offset;
+    }
+
+    template<typename T, typename Alloc, typename Growth, size_t N>
+    void vector<T, Alloc, Growth, N>::assign(vector::size_type n, const T &x) {
+        if (n > capacity()) {/**先填好新空间再释放原有空间，x 可以引用自身元素*/
+            iterator new_start = alloc_and_fill(n, x);
+            Tiny::destroy(start, finish);
+            deallocate();
+            start = new_start;
+            finish = new_start + n;
+            end_of_storage = storage_end(new_start, n);
+        } else if (n > size()) {
+            std::fill(start, finish, x);
+            finish = Tiny::uninitialized_fill_n(finish, n - size(), x);
+        } else {
+            erase(std::fill_n(start, n, x), finish);
+        }
+    }
+
+    template<typename T, typename Alloc, typename Growth, size_t N>
+    template<typename InputIterator, typename>
+    void vector<T, Alloc, Growth, N>::assign(InputIterator first, InputIterator last) {
+        if constexpr (is_forward_iterator<InputIterator>) {
+            const size_type n = range_length(first, last);
+            if (n > capacity()) {
+                iterator new_start = allocate_and_copy(n, first, last);
+                Tiny::destroy(start, finish);
                 deallocate();
                 start = new_start;
+                finish = new_start + n;
+                end_of_storage = storage_end(new_start, n);
+            } else if (size() >= n) {
+                iterator new_finish = std::copy(first, last, start);
+                Tiny::destroy(new_finish, finish);
                 finish = new_finish;
-                end_of_storage = new_start + len;
+            } else {
+                InputIterator mid = range_advance(first, size());
+                std::copy(first, mid, start);
+                finish = Tiny::uninitialized_copy(mid, last, finish);
+            }
+        } else {
+            iterator cur = start;
+            for (; first != last && cur != finish; ++first, ++cur)
+                *cur = *first;
+            if (first == last) {
+                erase(cur, finish);
+            } else {
+                for (; first != last; ++first)
+                    emplace_back(*first);
+            }
+        }
+    }
+
+    template<typename T, typename Alloc, typename Growth, size_t N>
+    vector<T, Alloc, Growth, N> &vector<T, Alloc, Growth, N>::operator=(const vector &x) {
+        if (this != &x) {
+            const size_type n = x.size();
+            if (n > capacity()) {/**空间不足：先完成复制再释放原有空间，复制失败时容器保持不变*/
+                iterator new_start = allocate_and_copy(n, x.begin(), x.end());
+                Tiny::destroy(start, finish);
+                deallocate();
+                start = new_start;
+                end_of_storage = storage_end(new_start, n);
+            } else if (size() >= n) {
+                iterator i = std::copy(x.begin(), x.end(), start);
+                Tiny::destroy(i, finish);
+            } else {
+                std::copy(x.begin(), x.begin() + size(), start);
+                Tiny::uninitialized_copy(x.begin() + size(), x.end(), finish);
             }
+            finish = start + n;
         }
+        return *this;
     }
 
-    template<typename T, typename Alloc>
-    void vector<T, Alloc>::insert_aux(vector::iterator position, const T &x) {
+    template<typename T, typename Alloc, typename Growth, size_t N>
+    vector<T, Alloc, Growth, N> &vector<T, Alloc, Growth, N>::operator=(vector &&x) noexcept(std::is_empty<Alloc>::value &&
+                                                                 (N == 0 || std::is_nothrow_move_constructible<T>::value)) {
+        if (this == &x)
+            return *this;
+        if (same_allocator(x)) {
+            vector(std::move(x)).swap(*this);
+        } else {/**x 的空间只能由它自己的分配器释放，只能逐个移动元素*/
+            clear();
+            reserve(x.size());
+            finish = Tiny::uninitialized_move(x.begin(), x.end(), start);
+            x.clear();
+        }
+        return *this;
+    }
+
+    template<typename T, typename Alloc, typename Growth, size_t N>
+    template<typename... Args>
+    void vector<T, Alloc, Growth, N>::insert_aux(vector::iterator position, Args &&... args) {
         if (end() != end_of_storage) {
-            construct(finish, *(finish - 1));
+            /**先构造出新元素，args 引用自身元素时仍读取到原值*/
+            T x_copy(std::forward<Args>(args)...);
+            construct(finish, std::move(*(finish - 1)));
             ++finish;
-            T x_copy = x;
-            std::copy_backward(position, finish - 2, finish - 1);
-            *position = x_copy;
+            std::move_backward(position, finish - 2, finish - 1);
+            *position = std::move(x_copy);
+        } else if constexpr (relocatable && std::is_nothrow_move_constructible<T>::value) {
+            /**同 insert(position, n, x)：先构造副本，腾出空位后的移动构造不会抛出*/
+            T x_copy(std::forward<Args>(args)...);
+            position = relocate_gap(position, 1, recommend(1));
+            construct(position, std::move(x_copy));
         } else {
-            const size_type old_size = size();
-            const size_type len = old_size != 0 ? 2 * old_size : 1;
-            iterator new_start = data_allocator::allocate(len);
-            iterator new_finish = new_start;
-            try {
-                new_finish = uninitialized_copy(start, position, new_start);
-                construct(new_finish, x);
-                ++new_finish;
-                new_finish = uninitialized_copy(position, finish, new_finish);
-            }
-            catch (...) {
-                destroy(new_start, new_finish);
-                data_allocator::deallocate(new_start, len);
-                throw;
-            }
-            destroy(begin(), end());
-            deallocate();
-            start = new_start;
-            finish = new_finish;
-            end_of_storage = new_start + len;
+            reallocate_insert(position, 1, recommend(1),
+                              [&args...](iterator p) { construct(p, std::forward<Args>(args)...); });
         }
     }
+
+    template<typename T, typename Alloc, typename Growth, size_t N>
+    template<typename Construct>
+    void vector<T, Alloc, Growth, N>::reallocate_insert(vector::iterator position, vector::size_type n, vector::size_type len,
+                                             Construct construct_new) {
+        iterator new_start = allocate_storage(len);
+        iterator new_position = new_start + (position - start);
+        iterator new_finish = new_start;
+        int stage = 0;/**0：尚未构造；1：新元素已构造；2：前段也已搬迁*/
+        try {
+            /**先构造新元素，其实参引用自身元素时仍读取到原值*/
+            construct_new(new_position);
+            stage = 1;
+            Tiny::uninitialized_move_if_noexcept(start, position, new_start);
+            stage = 2;
+            new_finish = Tiny::uninitialized_move_if_noexcept(position, finish, new_position + n);
+        }
+        catch (...) {
+            if (stage == 2)
+                Tiny::destroy(new_start, new_position + n);
+            else if (stage == 1)
+                Tiny::destroy(new_position, new_position + n);
+            release_storage(new_start, len);
+            throw;
+        }
+        Tiny::destroy(start, finish);
+        deallocate();
+        start = new_start;
+        finish = new_finish;
+        end_of_storage = storage_end(new_start, len);
+    }
+
+    template<typename T, typename Alloc, typename Growth, size_t N>
+    void swap(vector<T, Alloc, Growth, N> &x, vector<T, Alloc, Growth, N> &y) noexcept(noexcept(x.swap(y))) {
+        x.swap(y);
+    }
 }
 
 
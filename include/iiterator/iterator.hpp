@@ -8,6 +8,7 @@
 #define TINY_STL_ITERATOR_HPP
 
 #include <cstddef>
+#include <type_traits>
 
 namespace Tiny {
     struct input_iterator_tag {
@@ -143,134 +144,23 @@ namespace Tiny {
     struct _false_type {
     };
 
+    /**由 std::is_trivially_* 计算，可平凡拷贝构造与析构的用户类型同样视为 POD*/
     template<typename type>
     struct _type_traits {
         typedef _true_type this_dummy_member_must_be_first;
-        typedef _false_type has_trivial_default_constructor;
-        typedef _false_type has_trivial_copy_constructor;
-        typedef _false_type has_trivial_assignment_constructor;
-        typedef _false_type has_trivial_destructor;
-        typedef _false_type is_POD_type;
+        typedef typename std::conditional<std::is_trivially_default_constructible<type>::value,
+                _true_type, _false_type>::type has_trivial_default_constructor;
+        typedef typename std::conditional<std::is_trivially_copy_constructible<type>::value,
+                _true_type, _false_type>::type has_trivial_copy_constructor;
+        typedef typename std::conditional<std::is_trivially_copy_assignable<type>::value,
+                _true_type, _false_type>::type has_trivial_assignment_constructor;
+        typedef typename std::conditional<std::is_trivially_destructible<type>::value,
+                _true_type, _false_type>::type has_trivial_destructor;
+        typedef typename std::conditional<std::is_trivially_copy_constructible<type>::value &&
+                                          std::is_trivially_destructible<type>::value &&
+                                          std::is_copy_assignable<type>::value,
+                _true_type, _false_type>::type is_POD_type;
     };
-    template<>
-    struct _type_traits<char> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<>
-    struct _type_traits<signed char> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<>
-    struct _type_traits<unsigned char> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<>
-    struct _type_traits<short> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<>
-    struct _type_traits<unsigned short> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<>
-    struct _type_traits<int> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<>
-    struct _type_traits<unsigned int> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<>
-    struct _type_traits<long> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<>
-    struct _type_traits<unsigned long> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<>
-    struct _type_traits<float> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-
-    template<>
-    struct _type_traits<double> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<>
-    struct _type_traits<long double> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-    template<typename T>
-    struct _type_traits<T *> {
-        typedef _true_type this_dummy_member_must_be_first;
-        typedef _true_type has_trivial_default_constructor;
-        typedef _true_type has_trivial_copy_constructor;
-        typedef _true_type has_trivial_assignment_constructor;
-        typedef _true_type has_trivial_destructor;
-        typedef _true_type is_POD_type;
-    };
-
 
 }
 
@@ -1,6 +1,8 @@
 #ifndef TINY_STL_ITERATOR_HPP
 #define TINY_STL_ITERATOR_HPP
 #include <cstddef>
+#include <iterator>
+#include <type_traits>
 
 namespace Tiny
 {
@@ -219,6 +221,22 @@ namespace Tiny
         advance_(i, n, iterator_category(i));
     }
 
+    /**
+     * @brief 判断迭代器能否多趟遍历（前向迭代器及以上），本库与标准库的迭代器标签都能识别
+     *
+     * 容器据此先求出区间长度、只分配一次；单趟的输入迭代器只能边读边插入。
+     */
+    template <typename Iterator, typename Category = typename std::iterator_traits<Iterator>::iterator_category>
+    constexpr bool is_forward_iterator = std::is_base_of<forward_iterator_tag, Category>::value ||
+        std::is_base_of<std::forward_iterator_tag, Category>::value;
+
+    /**
+     * @brief 判断迭代器能否随机访问，本库与标准库的迭代器标签都能识别
+     */
+    template <typename Iterator, typename Category = typename std::iterator_traits<Iterator>::iterator_category>
+    constexpr bool is_random_access_iterator = std::is_base_of<random_access_iterator_tag, Category>::value ||
+        std::is_base_of<std::random_access_iterator_tag, Category>::value;
+
     ///< 类型判断结构体
     struct true_type
     {
@@ -230,149 +248,28 @@ namespace Tiny
 
     /**
      * @brief 类型特征结构体，用于判断类型是否具有某些特性
+     *
+     * 由编译器内建的 std::is_trivially_* 计算，用户自定义的结构体、std::pair<int, int> 等类型
+     * 同样走 memmove 与跳过析构的快速路径，无需再为每个类型手写特化；仍可为个别类型显式特化以覆盖。
+     * is_POD_type 表示拷贝构造可由按字节拷贝代替、并且无需析构；赋值运算符仍可能是用户定义的，
+     * 因此未初始化区间的快速路径只能按字节拷贝或构造，不能赋值。
      */
     template <typename type>
     struct type_traits
     {
         typedef true_type this_dummy_member_must_be_first;
-        typedef false_type has_trivial_default_constructor;
-        typedef false_type has_trivial_copy_constructor;
-        typedef false_type has_trivial_assignment_constructor;
-        typedef false_type has_trivial_destructor;
-        typedef false_type is_POD_type;
-    };
-
-    /** 对基础数据类型进行偏特化 */
-    template <typename T>
-    struct type_traits<T*>
-    {
-        typedef true_type this_dummy_member_must_be_first;
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    ///< 对不同的基础数据类型进行特化
-    template <>
-    struct type_traits<char>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<signed char>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<unsigned char>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<short>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<unsigned short>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<int>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<unsigned int>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<long>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<unsigned long>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<float>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<double>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
-    };
-
-    template <>
-    struct type_traits<long double>
-    {
-        typedef true_type has_trivial_default_constructor;
-        typedef true_type has_trivial_copy_constructor;
-        typedef true_type has_trivial_assignment_constructor;
-        typedef true_type has_trivial_destructor;
-        typedef true_type is_POD_type;
+        typedef typename std::conditional<std::is_trivially_default_constructible<type>::value,
+                                          true_type, false_type>::type has_trivial_default_constructor;
+        typedef typename std::conditional<std::is_trivially_copy_constructible<type>::value,
+                                          true_type, false_type>::type has_trivial_copy_constructor;
+        typedef typename std::conditional<std::is_trivially_copy_assignable<type>::value,
+                                          true_type, false_type>::type has_trivial_assignment_constructor;
+        typedef typename std::conditional<std::is_trivially_destructible<type>::value,
+                                          true_type, false_type>::type has_trivial_destructor;
+        typedef typename std::conditional<std::is_trivially_copy_constructible<type>::value &&
+                                          std::is_trivially_destructible<type>::value &&
+                                          std::is_copy_assignable<type>::value,
+                                          true_type, false_type>::type is_POD_type;
     };
 }
 
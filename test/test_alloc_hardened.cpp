@@ -0,0 +1,207 @@
+// 加固模式在编译期开启，须在包含分配器头文件之前定义
+#define TINY_STL_ALLOC_HARDENED 1
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "allocator/allocator.hpp"
+#include "container/list.hpp"
+#include "container/vector.hpp"
+
+using namespace Tiny;
+
+static_assert(alloc_hardened_enabled, "TINY_STL_ALLOC_HARDENED 未生效");
+
+// 用户数据不与链接字、块头重叠，且满足对齐
+TEST(AllocHardenedTest, BlocksStayAlignedAndIsolated)
+{
+    using Pool = default_alloc_template<false, 20>;
+    std::vector<void*> blocks;
+    for (size_t n = 1; n <= 64; ++n)
+    {
+        void* p = Pool::allocate(n);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % Pool::ALIGN, 0u);
+        std::memset(p, 0x5a, n);
+        blocks.push_back(p);
+    }
+    for (size_t n = 1; n <= 64; ++n)
+        Pool::deallocate(blocks[n - 1], n);
+
+    // 释放后重新取出的块可以完整写入，填充检查不会误报
+    for (int round = 0; round < 3; ++round)
+    {
+        for (size_t n = 1; n <= 64; ++n)
+            blocks[n - 1] = Pool::allocate(n);
+        for (size_t n = 1; n <= 64; ++n)
+            Pool::deallocate(blocks[n - 1], n);
+    }
+}
+
+TEST(AllocHardenedTest, FreedBlocksArePoisoned)
+{
+    using Pool = default_alloc_template<false, 21>;
+    auto* p = static_cast<unsigned char*>(Pool::allocate(32));
+    std::memset(p, 0, 32);
+    Pool::deallocate(p, 32);
+    for (size_t i = 0; i < 32; ++i)
+        EXPECT_EQ(p[i], block_guard<Pool::ALIGN>::POISON);
+}
+
+TEST(AllocHardenedTest, ReallocateAndTrim)
+{
+    using Pool = default_alloc_template<false, 22>;
+    auto* p = static_cast<char*>(Pool::allocate(20));
+    std::memcpy(p, "0123456789abcdefghi", 20);
+    p = static_cast<char*>(Pool::reallocate(p, 20, 24)); // 同一类别也要换块，块头记录的大小随之更新
+    EXPECT_STREQ(p, "0123456789abcdefghi");
+    p = static_cast<char*>(Pool::reallocate(p, 24, 1000));
+    EXPECT_STREQ(p, "0123456789abcdefghi");
+    Pool::deallocate(p, 1000);
+
+    std::vector<void*> burst;
+    for (int i = 0; i < 10000; ++i)
+        burst.push_back(Pool::allocate(48));
+    for (auto q : burst)
+        Pool::deallocate(q, 48);
+    Pool::trim();
+    for (int i = 0; i < 10000; ++i)
+        burst[i] = Pool::allocate(48);
+    for (auto q : burst)
+        Pool::deallocate(q, 48);
+}
+
+TEST(AllocHardenedTest, ContainersAndThreads)
+{
+    vector<std::string> v;
+    list<std::string> l;
+    for (int i = 0; i < 1000; ++i)
+    {
+        v.push_back(std::to_string(i));
+        l.push_back(std::to_string(i));
+    }
+    EXPECT_EQ(v[999], "999");
+    EXPECT_EQ(l.back(), "999");
+
+    using Pool = default_alloc_template<true, 23>;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([]
+        {
+            std::vector<void*> ptrs;
+            for (int i = 0; i < 5000; ++i)
+                ptrs.push_back(Pool::allocate(8 + i % 200));
+            for (int i = 0; i < 5000; ++i)
+                Pool::deallocate(ptrs[i], 8 + i % 200);
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+}
+
+// 池中每个块都带保护字节：放不下保护字节的池化请求交给一级配置器，大小为 0 的请求也带保护
+TEST(AllocHardenedTest, EveryPooledBlockIsGuarded)
+{
+    using Pool = default_alloc_template<false, 25>;
+    const size_t first = Pool::MAX_BYTES - block_guard<Pool::ALIGN>::OVERHEAD + 1;
+    std::vector<void*> blocks;
+    for (size_t n = first; n <= Pool::MAX_BYTES; ++n)
+    {
+        void* p = Pool::allocate(n);
+        std::memset(p, 0x5a, n);
+        blocks.push_back(p);
+    }
+    if (alloc_stats_enabled)
+    {
+        EXPECT_EQ(Pool::stats().large_allocations, blocks.size());
+    }
+    for (size_t n = first; n <= Pool::MAX_BYTES; ++n)
+        Pool::deallocate(blocks[n - first], n);
+
+    void* zero = Pool::allocate(0);
+    void* other = Pool::allocate(0);
+    EXPECT_NE(zero, other);
+    Pool::deallocate(other, 0);
+    Pool::deallocate(zero, 0);
+}
+
+using AllocHardenedDeathTest = ::testing::Test;
+
+TEST_F(AllocHardenedDeathTest, DoubleFree)
+{
+    using Pool = default_alloc_template<false, 24>;
+    EXPECT_DEATH({
+        void* p = Pool::allocate(40);
+        Pool::deallocate(p, 40);
+        Pool::deallocate(p, 40);
+    }, "double free");
+}
+
+TEST_F(AllocHardenedDeathTest, WrongSizeFree)
+{
+    using Pool = default_alloc_template<false, 24>;
+    EXPECT_DEATH({
+        void* p = Pool::allocate(40);
+        Pool::deallocate(p, 48);
+    }, "free with wrong size .*allocated 40 bytes, freed as 48");
+}
+
+TEST_F(AllocHardenedDeathTest, ZeroSizeDoubleFree)
+{
+    using Pool = default_alloc_template<false, 24>;
+    EXPECT_DEATH({
+        void* p = Pool::allocate(0);
+        Pool::deallocate(p, 0);
+        Pool::deallocate(p, 0);
+    }, "double free");
+}
+
+TEST_F(AllocHardenedDeathTest, InvalidPointer)
+{
+    using Pool = default_alloc_template<false, 24>;
+    EXPECT_DEATH({
+        auto* p = static_cast<char*>(Pool::allocate(64));
+        Pool::deallocate(p + 16, 32);
+    }, "invalid pointer");
+}
+
+TEST_F(AllocHardenedDeathTest, Overflow)
+{
+    using Pool = default_alloc_template<false, 24>;
+    EXPECT_DEATH({
+        auto* p = static_cast<char*>(Pool::allocate(40));
+        p[40] = 'x';
+        Pool::deallocate(p, 40);
+    }, "buffer overflow");
+}
+
+TEST_F(AllocHardenedDeathTest, WriteAfterFree)
+{
+    using Pool = default_alloc_template<false, 24>;
+    EXPECT_DEATH({
+        auto* p = static_cast<char*>(Pool::allocate(40));
+        Pool::deallocate(p, 40);
+        p[3] = 'x';
+        Pool::allocate(40);
+    }, "write after free");
+}
+
+TEST_F(AllocHardenedDeathTest, CorruptedFreeListLink)
+{
+    using Pool = default_alloc_template<false, 24>;
+    EXPECT_DEATH({
+        auto* a = static_cast<char*>(Pool::allocate(40));
+        Pool::deallocate(a, 40);
+        // 模拟前一块越界写改动了空闲块 a 的链接字最低字节
+        a[-static_cast<ptrdiff_t>(block_guard<Pool::ALIGN>::FRONT)] ^= 1;
+        Pool::allocate(40);
+    }, "corrupted free-list link");
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,8 +1,24 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <vector>
 #include <list>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include "allocator/allocator.hpp"
+#include "allocator/arena.hpp"
+#include "allocator/background_trimmer.hpp"
+#include "allocator/memory_resource.hpp"
+#include "allocator/numa.hpp"
+#include "allocator/object_pool.hpp"
+#include "container/deque.hpp"
+#include "container/list.hpp"
+#include "container/vector.hpp"
 
 using namespace Tiny;
 
@@ -32,12 +48,17 @@ TEST(MallocAllocatorTest, Reallocation)
     malloc_alloc::deallocate(new_p, 20 * sizeof(int));
 }
 
+namespace
+{
+    std::atomic<int> oom_handler_runs{0};
+}
+
 TEST(MallocAllocatorTest, OutOfMemoryHandler)
 {
-    bool handler_called = false;
-    const auto old_handler = malloc_alloc::set_malloc_handler([&]()
+    oom_handler_runs = 0;
+    const auto old_handler = malloc_alloc::set_malloc_handler([]
     {
-        handler_called = true;
+        ++oom_handler_runs;
         throw std::bad_alloc();
     });
 
@@ -47,10 +68,76 @@ TEST(MallocAllocatorTest, OutOfMemoryHandler)
                  malloc_alloc::deallocate(p, 0);
                  }, std::bad_alloc);
 
-    EXPECT_TRUE(handler_called);
+    EXPECT_EQ(oom_handler_runs, 1);
+    malloc_alloc::set_malloc_handler(old_handler);
+}
+
+// 处理函数既不释放内存也不抛出异常时，重试次数有上限，realloc 失败同样会调用处理函数
+TEST(MallocAllocatorTest, BoundedOomRetries)
+{
+    oom_handler_runs = 0;
+    const auto old_handler = malloc_alloc::set_malloc_handler([] { ++oom_handler_runs; });
+    const unsigned old_limit = malloc_alloc::set_oom_retry_limit(3);
+
+    EXPECT_THROW(malloc_alloc::allocate(std::numeric_limits<size_t>::max()), std::bad_alloc);
+    EXPECT_EQ(oom_handler_runs, 3);
+
+    void* p = malloc_alloc::allocate(64);
+    EXPECT_THROW(malloc_alloc::reallocate(p, 64, std::numeric_limits<size_t>::max() - 64), std::bad_alloc);
+    EXPECT_EQ(oom_handler_runs, 6);
+    malloc_alloc::deallocate(p, 64); // 失败的 realloc 不影响原内存
+
+    malloc_alloc::set_oom_retry_limit(0);
+    EXPECT_THROW(malloc_alloc::allocate(std::numeric_limits<size_t>::max()), std::bad_alloc);
+    EXPECT_EQ(oom_handler_runs, 6);
+
+    malloc_alloc::set_oom_retry_limit(old_limit);
     malloc_alloc::set_malloc_handler(old_handler);
 }
 
+// 分配失败时先调用登记的缓存回收函数：内存池归还完全空闲的区块，而不是直接失败
+TEST(MallocAllocatorTest, OomReleasesPoolCaches)
+{
+    using Pool = default_alloc_template<false, 30>;
+    using MtPool = default_alloc_template<true, 31>;
+    std::vector<void*> burst;
+    for (int i = 0; i < 20000; ++i)
+        burst.push_back(Pool::allocate(64));
+    for (auto p : burst)
+        Pool::deallocate(p, 64);
+    for (int i = 0; i < 20000; ++i)
+        burst[i] = MtPool::allocate(64);
+    for (auto p : burst)
+        MtPool::deallocate(p, 64);
+    ASSERT_GT(Pool::held_bytes(), 0u);
+    ASSERT_GT(MtPool::held_bytes(), 0u);
+
+    const auto old_handler = malloc_alloc::set_malloc_handler(nullptr);
+    EXPECT_THROW(malloc_alloc::allocate(std::numeric_limits<size_t>::max()), std::bad_alloc);
+    malloc_alloc::set_malloc_handler(old_handler);
+    EXPECT_EQ(Pool::held_bytes(), 0u);
+    EXPECT_EQ(MtPool::held_bytes(), 0u);
+
+    // 回收之后池照常可用
+    void* p = Pool::allocate(64);
+    Pool::deallocate(p, 64);
+    EXPECT_GT(Pool::held_bytes(), 0u);
+}
+
+// 单线程池只由扩充它的线程回收，其他线程分配失败时不会并发改动它
+TEST(MallocAllocatorTest, OomSkipsForeignSingleThreadPool)
+{
+    using Pool = default_alloc_template<false, 32>;
+    void* p = Pool::allocate(64);
+    Pool::deallocate(p, 64);
+    const size_t held = Pool::held_bytes();
+    std::thread([]
+    {
+        EXPECT_THROW(malloc_alloc::allocate(std::numeric_limits<size_t>::max()), std::bad_alloc);
+    }).join();
+    EXPECT_EQ(Pool::held_bytes(), held);
+}
+
 // 测试二级分配器 (default_alloc_template)
 class DefaultAllocatorTest : public ::testing::Test
 {
@@ -106,6 +193,21 @@ TEST_F(DefaultAllocatorTest, ReuseMemory)
     Alloc::deallocate(p2, 16);
 }
 
+// 测试大小为 0 的请求：按最小类别分配，得到互不相同的指针，按大小 0 释放后归还最小类别
+TEST_F(DefaultAllocatorTest, ZeroSizeAllocation)
+{
+    void* a = Alloc::allocate(0);
+    void* b = Alloc::allocate(0);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_NE(a, b);
+    Alloc::deallocate(b, 0);
+    void* c = Alloc::allocate(1); // 与大小 0 同属最小类别
+    EXPECT_EQ(c, b);
+    Alloc::deallocate(c, 1);
+    Alloc::deallocate(a, 0);
+}
+
 TEST_F(DefaultAllocatorTest, Reallocation)
 {
     // 小内存重分配
@@ -128,6 +230,575 @@ TEST_F(DefaultAllocatorTest, Reallocation)
     Alloc::deallocate(new_p, MAX_BYTES * 2);
 }
 
+// 测试多线程模式下的二级分配器
+TEST(MultiThreadAllocatorTest, ConcurrentAllocation)
+{
+    constexpr int thread_num = 8;
+    constexpr int rounds = 2000;
+    std::vector<std::thread> workers;
+    std::atomic<int> errors{0};
+
+    for (int t = 0; t < thread_num; ++t)
+    {
+        workers.emplace_back([t, &errors]()
+        {
+            std::vector<std::pair<unsigned char*, size_t>> blocks;
+            for (int i = 0; i < rounds; ++i)
+            {
+                const size_t n = 1 + (i * 7 + t) % MAX_BYTES;
+                auto p = static_cast<unsigned char*>(mt_alloc::allocate(n));
+                std::memset(p, t, n);
+                blocks.emplace_back(p, n);
+                if (i % 3 == 0)
+                {
+                    // 校验内容未被其他线程覆盖后释放
+                    auto [q, m] = blocks.back();
+                    blocks.pop_back();
+                    for (size_t k = 0; k < m; ++k)
+                        if (q[k] != static_cast<unsigned char>(t))
+                            ++errors;
+                    mt_alloc::deallocate(q, m);
+                }
+            }
+            for (auto [q, m] : blocks)
+            {
+                for (size_t k = 0; k < m; ++k)
+                    if (q[k] != static_cast<unsigned char>(t))
+                        ++errors;
+                mt_alloc::deallocate(q, m);
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    EXPECT_EQ(errors.load(), 0);
+}
+
+TEST(MultiThreadAllocatorTest, CrossThreadFree)
+{
+    constexpr int n = 10000;
+    std::vector<void*> ptrs(n);
+
+    // 一个线程分配，另一个线程释放
+    std::thread producer([&]()
+    {
+        for (auto& p : ptrs)
+            p = mt_alloc::allocate(32);
+    });
+    producer.join();
+
+    std::thread consumer([&]()
+    {
+        for (auto p : ptrs)
+            mt_alloc::deallocate(p, 32);
+    });
+    consumer.join();
+
+    void* p = mt_alloc::allocate(32);
+    ASSERT_NE(p, nullptr);
+    mt_alloc::deallocate(p, 32);
+}
+
+// 测试几何尺寸类别：每个请求映射到能容纳它的最小类别
+TEST(SizeClassTest, GeometricClassesAreTight)
+{
+    using Classes = geometric_size_classes<16, 32768>;
+    EXPECT_EQ(Classes::NFREELISTS, 40u);
+    EXPECT_EQ(Classes::size(Classes::NFREELISTS - 1), 32768u);
+    for (size_t bytes = 1; bytes <= Classes::MAX_BYTES; ++bytes)
+    {
+        const size_t index = Classes::index(bytes);
+        ASSERT_LT(index, Classes::NFREELISTS);
+        ASSERT_GE(Classes::size(index), bytes);
+        ASSERT_EQ(Classes::size(index) % Classes::ALIGN, 0u);
+        if (index > 0)
+        {
+            ASSERT_LT(Classes::size(index - 1), bytes);
+        }
+    }
+}
+
+TEST(SizeClassTest, GeometricPoolAllocation)
+{
+    using Pool = default_alloc_template<false, 0, geometric_size_classes<16, 32768>>;
+    std::vector<std::pair<void*, size_t>> blocks;
+    for (size_t n = 1; n <= Pool::MAX_BYTES; n = n * 3 / 2 + 1)
+    {
+        void* p = Pool::allocate(n);
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 16, 0u); // SSE 对齐
+        std::memset(p, 0xab, n);
+        blocks.emplace_back(p, n);
+    }
+    for (auto [p, n] : blocks)
+        Pool::deallocate(p, n);
+    EXPECT_GT(Pool::trim(), 0u);
+}
+
+// 测试超过 max_align_t 的对齐边界：区块来源只保证 max_align_t 对齐，跨多个区块的每个块仍按 64 字节对齐
+TEST(SizeClassTest, CacheLineAlignedPool)
+{
+    using Pool = default_alloc_template<false, 0, geometric_size_classes<64, 32768>>;
+    static_assert(alloc_alignment<Pool>::value == 64);
+    std::vector<std::pair<void*, size_t>> blocks;
+    for (int round = 0; round < 20; ++round)
+    {
+        for (size_t n = 1; n <= Pool::MAX_BYTES; n = n * 3 / 2 + 1)
+        {
+            void* p = Pool::allocate(n);
+            ASSERT_NE(p, nullptr);
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0u);
+            std::memset(p, 0xcd, n);
+            blocks.emplace_back(p, n);
+        }
+    }
+    if (alloc_stats_enabled)
+    {
+        EXPECT_GT(Pool::stats().chunk_allocs, 1u);
+    }
+
+    // alloc_alignment 信任 ALIGN，超对齐类型直接走池化路径
+    struct alignas(64) Line
+    {
+        long value;
+    };
+    Line* lines = simple_alloc<Line, Pool>::allocate(3);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(lines) % 64, 0u);
+    simple_alloc<Line, Pool>::deallocate(lines, 3);
+
+    for (auto [p, n] : blocks)
+        Pool::deallocate(p, n);
+    EXPECT_GT(Pool::trim(), 0u);
+}
+
+// 测试 trim()：流量高峰过后完全空闲的区块应归还系统，仍在使用的区块保留
+TEST(AllocatorTrimTest, ReleaseFreeChunks)
+{
+    using Pool = default_alloc_template<false, 1>;
+    void* keep = Pool::allocate(24);
+
+    std::vector<void*> burst;
+    for (int i = 0; i < 100000; ++i)
+        burst.push_back(Pool::allocate(64));
+    const size_t peak = Pool::held_bytes();
+    for (auto p : burst)
+        Pool::deallocate(p, 64);
+
+    EXPECT_GT(Pool::trim(), 0u);
+    EXPECT_LT(Pool::held_bytes(), peak);
+
+    // 保留的内存块和回收后的分配仍然可用
+    std::memset(keep, 0x5a, 24);
+    void* p = Pool::allocate(64);
+    ASSERT_NE(p, nullptr);
+    Pool::deallocate(p, 64);
+    Pool::deallocate(keep, 24);
+}
+
+TEST(AllocatorTrimTest, MultiThreadTrim)
+{
+    using Pool = default_alloc_template<true, 1>;
+    std::atomic<bool> done{false};
+    std::thread worker([&done]()
+    {
+        // 并发分配释放，与 trim() 交错执行
+        while (!done.load())
+        {
+            std::vector<void*> ptrs;
+            for (int i = 0; i < 1000; ++i)
+                ptrs.push_back(Pool::allocate(16 + i % 100));
+            for (int i = 0; i < 1000; ++i)
+                Pool::deallocate(ptrs[i], 16 + i % 100);
+        }
+    });
+
+    std::vector<void*> burst;
+    for (int i = 0; i < 50000; ++i)
+        burst.push_back(Pool::allocate(48));
+    for (auto p : burst)
+        Pool::deallocate(p, 48);
+    size_t released = 0;
+    for (int i = 0; i < 20; ++i)
+        released += Pool::trim();
+    done = true;
+    worker.join();
+    EXPECT_GT(released, 0u);
+}
+
+TEST(AllocatorTrimTest, BackgroundTrimmer)
+{
+    using Pool = default_alloc_template<true, 2>;
+    std::vector<void*> burst;
+    std::thread([&burst]()
+    {
+        // 工作线程退出时缓存归还中心池，随后由后台线程回收
+        for (int i = 0; i < 50000; ++i)
+            burst.push_back(Pool::allocate(32));
+        for (auto p : burst)
+            Pool::deallocate(p, 32);
+    }).join();
+
+    const background_trimmer<Pool> trimmer(std::chrono::milliseconds(1));
+    for (int i = 0; i < 1000 && 0 == trimmer.released_bytes(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_GT(trimmer.released_bytes(), 0u);
+}
+
+// 测试统计快照：计数与内存占用在分配、释放、trim() 前后保持一致
+TEST(AllocatorStatsTest, SingleThreadCounters)
+{
+    if (!alloc_stats_enabled)
+        GTEST_SKIP() << "TINY_STL_ALLOC_STATS=0";
+    if (alloc_hardened_enabled)
+        GTEST_SKIP() << "TINY_STL_ALLOC_HARDENED=1 changes size classes";
+    using Pool = default_alloc_template<false, 3>;
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 100; ++i)
+        ptrs.push_back(Pool::allocate(24));
+    void* large = Pool::allocate(Pool::MAX_BYTES + 1);
+
+    auto s = Pool::stats();
+    EXPECT_EQ(s.allocations[2], 100u); // 24 字节属于第 3 个类别
+    EXPECT_EQ(s.large_allocations, 1u);
+    EXPECT_GE(s.refills, 1u);
+    EXPECT_GE(s.chunk_allocs, 1u);
+    EXPECT_EQ(s.thread_cache_bytes, 0u);
+    EXPECT_EQ(s.heap_size, Pool::held_bytes());
+
+    for (auto p : ptrs)
+        Pool::deallocate(p, 24);
+    Pool::deallocate(large, Pool::MAX_BYTES + 1);
+    s = Pool::stats();
+    EXPECT_EQ(s.deallocations[2], 100u);
+    EXPECT_EQ(s.large_deallocations, 1u);
+    // 全部释放后，已切分的内存全在自由链表中
+    EXPECT_EQ(s.free_list_bytes + s.pool_bytes, s.heap_size);
+
+    Pool::trim();
+    s = Pool::stats();
+    EXPECT_GE(s.chunks_released, 1u);
+    EXPECT_EQ(s.free_list_bytes + s.pool_bytes, s.heap_size);
+}
+
+TEST(AllocatorStatsTest, MultiThreadCounters)
+{
+    if (!alloc_stats_enabled)
+        GTEST_SKIP() << "TINY_STL_ALLOC_STATS=0";
+    if (alloc_hardened_enabled)
+        GTEST_SKIP() << "TINY_STL_ALLOC_HARDENED=1 changes size classes";
+    using Pool = default_alloc_template<true, 3>;
+    constexpr int thread_num = 4;
+    constexpr int per_thread = 1000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_num; ++t)
+    {
+        workers.emplace_back([]()
+        {
+            std::vector<void*> ptrs;
+            for (int i = 0; i < per_thread; ++i)
+                ptrs.push_back(Pool::allocate(64));
+            for (auto p : ptrs)
+                Pool::deallocate(p, 64);
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+
+    // 已退出线程的计数并入全局计数，缓存中的块全部归还中心链表
+    const auto s = Pool::stats();
+    EXPECT_EQ(s.allocations[7], static_cast<size_t>(thread_num * per_thread));
+    EXPECT_EQ(s.deallocations[7], static_cast<size_t>(thread_num * per_thread));
+    EXPECT_EQ(s.thread_cache_bytes, 0u);
+    EXPECT_EQ(s.free_list_bytes + s.pool_bytes, s.heap_size);
+}
+
+// 测试区块来源：大页与 mmap 区块可以正常切分、统计来源，并能由 trim() 归还
+TEST(AllocatorStatsTest, ChunkSources)
+{
+    if (!alloc_stats_enabled)
+        GTEST_SKIP() << "TINY_STL_ALLOC_STATS=0";
+    using HugePool = default_alloc_template<false, 5, default_size_classes, huge_page_chunk_source>;
+    using MmapPool = default_alloc_template<true, 5, default_size_classes, mmap_chunk_source>;
+
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 100000; ++i)
+    {
+        ptrs.push_back(HugePool::allocate(32));
+        std::memset(ptrs.back(), 0x11, 32);
+    }
+    auto s = HugePool::stats();
+    EXPECT_EQ(s.mmap_chunks + s.huge_page_chunks, s.chunk_allocs); // 正常环境下不会退回 malloc
+    for (auto p : ptrs)
+        HugePool::deallocate(p, 32);
+    EXPECT_GT(HugePool::trim(), 0u);
+    EXPECT_EQ(HugePool::stats().chunks_released, s.chunk_allocs);
+
+    void* p = MmapPool::allocate(64);
+    std::memset(p, 0x22, 64);
+    EXPECT_EQ(MmapPool::stats().mmap_chunks, 1u);
+    MmapPool::deallocate(p, 64);
+}
+
+// 测试慢启动补充：冷门类别只补充少量内存块，热门类别的批量逐次增大
+TEST(AllocatorStatsTest, AdaptiveRefillBatch)
+{
+    if (!alloc_stats_enabled)
+        GTEST_SKIP() << "TINY_STL_ALLOC_STATS=0";
+    if (alloc_hardened_enabled)
+        GTEST_SKIP() << "TINY_STL_ALLOC_HARDENED=1 changes size classes";
+    using Pool = default_alloc_template<false, 4>;
+
+    // 首次分配冷门尺寸只多切出一块挂在自由链表上，而不是固定的 19 块
+    void* rare = Pool::allocate(96);
+    EXPECT_EQ(Pool::stats().free_list_bytes, 96u);
+    Pool::deallocate(rare, 96);
+
+    constexpr size_t n = 10000;
+    std::vector<void*> ptrs;
+    for (size_t i = 0; i < n; ++i)
+        ptrs.push_back(Pool::allocate(16));
+    const auto s = Pool::stats();
+    EXPECT_LT(s.refills, n / 20); // 批量增长后补充次数远少于固定 20 块时的 500 次
+    for (auto p : ptrs)
+        Pool::deallocate(p, 16);
+}
+
+// 测试内存区分配器：按序切分、原地扩展、reset() 后复用已申请的内存块
+TEST(ArenaTest, BumpAllocation)
+{
+    arena a(1024);
+    auto p = static_cast<char*>(a.allocate(10));
+    auto q = static_cast<char*>(a.allocate(24));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % arena::ALIGN, 0u);
+    EXPECT_EQ(q, p + 16);
+
+    // 最近一次分配可以原地扩展或回退
+    std::memset(q, 0x5a, 24);
+    EXPECT_EQ(a.reallocate(q, 24, 100), q);
+    a.deallocate(q, 100);
+    EXPECT_EQ(a.allocate(8), q);
+
+    // 超过块大小的请求单独申请一个块
+    void* big = a.allocate(4096);
+    ASSERT_NE(big, nullptr);
+    std::memset(big, 0, 4096);
+
+    // 首轮之后负载不变，reset() 复用已有块，不再申请新块
+    size_t capacity = 0;
+    for (int round = 0; round < 10; ++round)
+    {
+        a.reset();
+        EXPECT_EQ(a.allocate(10), p);
+        for (int i = 0; i < 100; ++i)
+            a.allocate(40);
+        a.allocate(4096);
+        if (0 == round)
+            capacity = a.capacity();
+    }
+    EXPECT_EQ(a.capacity(), capacity);
+}
+
+TEST(ArenaTest, ScopedArenaWithContainers)
+{
+    using Arena = arena_alloc<1>;
+    arena request_arena;
+    for (int round = 0; round < 3; ++round)
+    {
+        scoped_arena<Arena> scope(request_arena);
+        EXPECT_EQ(&Arena::current(), &request_arena);
+
+        vector<int, Arena> v;
+        list<int, Arena> l;
+        deque<int, Arena> d(0, 0);
+        for (int i = 0; i < 1000; ++i)
+        {
+            v.push_back(i);
+            l.push_back(i);
+            d.push_back(i);
+        }
+        EXPECT_EQ(v.size(), 1000u);
+        EXPECT_EQ(l.size(), 1000u);
+        EXPECT_EQ(d.size(), 1000u);
+        EXPECT_EQ(v[999] + *d.begin() + l.back(), 1998);
+    }
+    EXPECT_NE(&Arena::current(), &request_arena); // 作用域结束后恢复线程默认内存区
+    EXPECT_GT(request_arena.capacity(), 0u);
+}
+
+// 测试分配器实例：无状态分配器不增加容器大小，不同容器可以使用不同的内存资源
+TEST(MemoryResourceTest, StatelessAllocatorsCostNothing)
+{
+    static_assert(sizeof(vector<int>) == 3 * sizeof(int*));
+    static_assert(sizeof(vector<int, arena_alloc<>>) == 3 * sizeof(int*));
+    static_assert(sizeof(list<int>) == sizeof(void*));
+    static_assert(sizeof(vector<int, polymorphic_alloc>) == 4 * sizeof(int*));
+}
+
+TEST(MemoryResourceTest, PerConnectionResources)
+{
+    monotonic_resource conn1;
+    monotonic_resource conn2;
+    {
+        vector<int, polymorphic_alloc> v1(&conn1);
+        vector<int, polymorphic_alloc> v2(&conn2);
+        list<int, polymorphic_alloc> l1(&conn1);
+        deque<int, polymorphic_alloc> d2(&conn2);
+        for (int i = 0; i < 1000; ++i)
+        {
+            v1.push_back(i);
+            v2.push_back(-i);
+            l1.push_back(i);
+            d2.push_back(i);
+        }
+        EXPECT_EQ(v1.get_allocator().resource(), &conn1);
+        EXPECT_EQ(d2.get_allocator().resource(), &conn2);
+        EXPECT_TRUE(v1.get_allocator() != v2.get_allocator());
+        EXPECT_EQ(v1[999] + v2[999] + l1.back() + d2.back(), 1998);
+    }
+    EXPECT_GT(conn1.capacity(), 0u);
+    EXPECT_GT(conn2.capacity(), 0u);
+
+    // 连接结束时整体释放
+    conn1.release();
+    EXPECT_EQ(conn1.capacity(), 0u);
+
+    // 默认构造的多态分配器使用二级配置器
+    vector<int, polymorphic_alloc> v(3, 7);
+    EXPECT_EQ(v.get_allocator(), polymorphic_alloc(default_resource()));
+    EXPECT_EQ(v[2], 7);
+}
+
+// 测试 NUMA 感知配置器：固定到节点的线程只使用该节点的池，单节点或不支持 NUMA 的环境同样可用
+TEST(NumaAllocatorTest, PinnedThreadsUseLocalPool)
+{
+    if (alloc_hardened_enabled)
+        GTEST_SKIP() << "TINY_STL_ALLOC_HARDENED=1 changes size classes";
+    using Numa = numa_alloc<4>;
+    const unsigned nodes = numa_topology::node_count();
+    ASSERT_GE(nodes, 1u);
+
+    std::vector<std::thread> workers;
+    std::atomic<int> errors{0};
+    for (unsigned t = 0; t < 2 * nodes; ++t)
+    {
+        workers.emplace_back([t, nodes, &errors]()
+        {
+            const unsigned node = t % nodes;
+            numa_pin_thread(node);
+            if (numa_current_node() != node || Numa::local_node() != node % 4)
+                ++errors;
+            std::vector<void*> ptrs;
+            for (int i = 0; i < 1000; ++i)
+            {
+                ptrs.push_back(Numa::allocate(48));
+                std::memset(ptrs.back(), static_cast<int>(t), 48);
+            }
+            for (auto p : ptrs)
+                Numa::deallocate(p, 48);
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    EXPECT_EQ(errors.load(), 0);
+    if (alloc_stats_enabled)
+    {
+        EXPECT_EQ(Numa::stats(0).allocations[5], 2000u); // 每个节点固定了两个线程
+    }
+    EXPECT_GT(Numa::trim(), 0u);
+}
+
+// 测试跨节点释放：节点 1 的线程释放节点 0 分配的内存块，块回到节点 0 的池，trim() 可以归还其区块
+TEST(NumaAllocatorTest, CrossNodeFreeReturnsToOwner)
+{
+    if (alloc_hardened_enabled)
+        GTEST_SKIP() << "TINY_STL_ALLOC_HARDENED=1 changes size classes";
+    using Numa = numa_alloc<2>;
+    constexpr size_t bytes = 120;
+    constexpr size_t index = default_size_classes::index(bytes);
+    Numa::trim();
+    const auto before0 = Numa::stats(0);
+    const auto before1 = Numa::stats(1);
+
+    std::vector<void*> ptrs;
+    std::thread producer([&ptrs]()
+    {
+        numa_thread_node() = 0; // 不依赖真实拓扑，直接指定节点
+        for (int i = 0; i < 4000; ++i)
+            ptrs.push_back(Numa::allocate(bytes));
+    });
+    producer.join();
+    for (void* p : ptrs)
+        EXPECT_EQ(Numa::owner_node(p), 0u);
+
+    std::thread consumer([&ptrs]()
+    {
+        numa_thread_node() = 1;
+        for (size_t i = 0; i < ptrs.size() / 2; ++i)
+            Numa::deallocate(ptrs[i], bytes);
+        Numa::deallocate_batch(bytes, ptrs.size() / 2, ptrs.data() + ptrs.size() / 2);
+    });
+    consumer.join(); // 线程退出时缓存归还给各自的池
+
+    if (alloc_stats_enabled)
+    {
+        EXPECT_EQ(Numa::stats(0).deallocations[index] - before0.deallocations[index], 4000u);
+        EXPECT_EQ(Numa::stats(1).deallocations[index], before1.deallocations[index]);
+        const size_t heap_before = Numa::stats(0).heap_size;
+        EXPECT_GT(Numa::trim(), 0u);
+        EXPECT_LT(Numa::stats(0).heap_size, heap_before);
+        EXPECT_EQ(Numa::stats(1).heap_size, before1.heap_size);
+    }
+    else
+    {
+        EXPECT_GT(Numa::trim(), 0u);
+    }
+}
+
+// 测试无锁中心自由链表：并发压入弹出后节点不丢失、不重复
+TEST(LockFreeFreeListTest, ConcurrentPushPop)
+{
+    struct Node
+    {
+        Node* free_list_link;
+    };
+
+    constexpr int thread_num = 8;
+    constexpr int per_thread = 1000;
+    std::vector<Node> nodes(thread_num * per_thread);
+    lock_free_free_list<Node> list;
+    for (auto& node : nodes)
+        list.push(&node, &node);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_num; ++t)
+    {
+        workers.emplace_back([&list]()
+        {
+            for (int i = 0; i < 20000; ++i)
+            {
+                size_t count = 0;
+                Node* chain = list.pop(4, count);
+                if (nullptr == chain)
+                    continue;
+                Node* tail = chain;
+                while (nullptr != tail->free_list_link)
+                    tail = tail->free_list_link;
+                list.push(chain, tail);
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+
+    std::vector<Node*> seen;
+    for (Node* p = list.pop_all(); nullptr != p; p = p->free_list_link)
+        seen.push_back(p);
+    std::sort(seen.begin(), seen.end());
+    EXPECT_EQ(seen.size(), nodes.size());
+    EXPECT_EQ(std::unique(seen.begin(), seen.end()), seen.end());
+    EXPECT_TRUE(list.empty());
+}
+
 // 测试 simple_alloc 封装
 TEST(SimpleAllocTest, TypeSpecificAllocation)
 {
@@ -157,6 +828,51 @@ TEST(SimpleAllocTest, ObjectAllocation)
     StructAlloc::deallocate(arr, 10);
 }
 
+// 测试超对齐类型：simple_alloc 自动改走对齐分配，两级配置器与各种分配器都返回满足 alignof(T) 的地址
+struct alignas(64) CacheLineCounter
+{
+    long value;
+};
+
+template <typename Alloc>
+void check_over_aligned(const Alloc& a = Alloc())
+{
+    using CounterAlloc = simple_alloc<CacheLineCounter, Alloc>;
+    std::vector<std::pair<CacheLineCounter*, size_t>> blocks;
+    for (size_t n : {1, 2, 3, 100})
+    {
+        CacheLineCounter* p = CounterAlloc::allocate(a, n);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0u);
+        std::memset(static_cast<void*>(p), 0x3c, n * sizeof(CacheLineCounter));
+        blocks.emplace_back(p, n);
+    }
+    for (auto [p, n] : blocks)
+        CounterAlloc::deallocate(a, p, n);
+}
+
+TEST(SimpleAllocTest, OverAlignedTypes)
+{
+    check_over_aligned<alloc>();
+    check_over_aligned<mt_alloc>();
+    check_over_aligned<malloc_alloc>();
+    check_over_aligned<arena_alloc<2>>();
+    check_over_aligned<numa_alloc<>>();
+    monotonic_resource resource;
+    check_over_aligned<polymorphic_alloc>(&resource);
+    check_over_aligned<polymorphic_alloc>();
+
+    // 二级配置器直接调用
+    void* p = alloc::allocate_aligned(40, 32);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 32, 0u);
+    alloc::deallocate_aligned(p, 40, 32);
+
+    vector<CacheLineCounter> counters;
+    for (int i = 0; i < 100; ++i)
+        counters.push_back(CacheLineCounter{i});
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&counters[0]) % 64, 0u);
+    EXPECT_EQ(counters[99].value, 99);
+}
+
 // 测试未初始化内存操作
 TEST(UninitializedMemoryTest, FillN)
 {
@@ -208,6 +924,214 @@ TEST(UninitializedMemoryTest, Fill)
     alloc::deallocate(arr, n * sizeof(std::string));
 }
 
+/** 拷贝构造平凡、赋值运算符由用户定义的类型：视为 POD，但未初始化内存上不能调用其赋值运算符 */
+struct AssignCounted
+{
+    static inline int assigns = 0;
+    int value;
+
+    AssignCounted(const AssignCounted&) = default;
+
+    AssignCounted& operator=(const AssignCounted& other)
+    {
+        ++assigns;
+        value = other.value;
+        return *this;
+    }
+};
+
+// 测试 POD 快速路径在非指针迭代器上逐个构造，而不是对未初始化的目标赋值
+TEST(UninitializedMemoryTest, PodFallbackConstructs)
+{
+    static_assert(std::is_same<type_traits<AssignCounted>::is_POD_type, true_type>::value);
+    const AssignCounted src[4] = {{1}, {2}, {3}, {4}};
+    std::vector<AssignCounted> dest(4); // 非指针迭代器
+    AssignCounted::assigns = 0;
+
+    Tiny::uninitialized_copy(src, src + 4, dest.begin());
+    EXPECT_EQ(dest[3].value, 4);
+    Tiny::uninitialized_fill(dest.begin(), dest.end(), AssignCounted{7});
+    EXPECT_EQ(dest[0].value, 7);
+    Tiny::uninitialized_fill_n(dest.begin(), 2, AssignCounted{9});
+    EXPECT_EQ(dest[1].value, 9);
+    EXPECT_EQ(dest[2].value, 7);
+    EXPECT_EQ(AssignCounted::assigns, 0);
+}
+
+// 统计拷贝与移动次数的元素类型，Nothrow 决定移动构造是否声明为 noexcept
+template <bool Nothrow>
+struct Tracked
+{
+    static inline int copies = 0;
+    static inline int moves = 0;
+    std::string value;
+
+    explicit Tracked(std::string v) : value(std::move(v))
+    {
+    }
+
+    Tracked(const Tracked& other) : value(other.value)
+    {
+        ++copies;
+    }
+
+    Tracked(Tracked&& other) noexcept(Nothrow) : value(std::move(other.value))
+    {
+        ++moves;
+    }
+
+    Tracked& operator=(const Tracked& other)
+    {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+
+    Tracked& operator=(Tracked&& other) noexcept(Nothrow)
+    {
+        value = std::move(other.value);
+        ++moves;
+        return *this;
+    }
+
+    static void reset()
+    {
+        copies = moves = 0;
+    }
+};
+
+TEST(UninitializedMemoryTest, MoveAndRelocate)
+{
+    constexpr int n = 4;
+    std::string src[n] = {"a", "b", "c", std::string(64, 'd')};
+    auto* dest = static_cast<std::string*>(alloc::allocate(n * sizeof(std::string)));
+    EXPECT_EQ(Tiny::uninitialized_move(src, src + n, dest), dest + n);
+    EXPECT_EQ(dest[3], std::string(64, 'd'));
+    EXPECT_TRUE(src[3].empty()); // 长字符串被移走
+
+    // 搬迁后源对象已析构，只需析构目标
+    auto* relocated = static_cast<std::string*>(alloc::allocate(n * sizeof(std::string)));
+    Tiny::uninitialized_relocate(dest, dest + n, relocated);
+    EXPECT_EQ(relocated[0], "a");
+    EXPECT_EQ(relocated[3], std::string(64, 'd'));
+    Tiny::destroy(relocated, relocated + n);
+    alloc::deallocate(relocated, n * sizeof(std::string));
+    alloc::deallocate(dest, n * sizeof(std::string));
+
+    // 移动构造可能抛出异常时退回拷贝，保证源区间完好
+    using MayThrow = Tracked<false>;
+    using NoThrow = Tracked<true>;
+    MayThrow throwing[2] = {MayThrow("x"), MayThrow("y")};
+    NoThrow nothrow[2] = {NoThrow("x"), NoThrow("y")};
+    auto* a = static_cast<MayThrow*>(alloc::allocate(2 * sizeof(MayThrow)));
+    auto* b = static_cast<NoThrow*>(alloc::allocate(2 * sizeof(NoThrow)));
+    MayThrow::reset();
+    NoThrow::reset();
+    Tiny::uninitialized_move_if_noexcept(throwing, throwing + 2, a);
+    Tiny::uninitialized_move_if_noexcept(nothrow, nothrow + 2, b);
+    EXPECT_EQ(MayThrow::copies, 2);
+    EXPECT_EQ(MayThrow::moves, 0);
+    EXPECT_EQ(NoThrow::copies, 0);
+    EXPECT_EQ(NoThrow::moves, 2);
+    Tiny::destroy(a, a + 2);
+    Tiny::destroy(b, b + 2);
+    alloc::deallocate(a, 2 * sizeof(MayThrow));
+    alloc::deallocate(b, 2 * sizeof(NoThrow));
+}
+
+// 容器扩容与移位改为移动：vector 扩容不再拷贝，deque/list 接受右值
+TEST(UninitializedMemoryTest, ContainersMoveElements)
+{
+    using Item = Tracked<true>;
+    Item::reset();
+    {
+        Tiny::vector<Item> v;
+        for (int i = 0; i < 1000; ++i)
+            v.push_back(Item(std::to_string(i)));
+        EXPECT_EQ(Item::copies, 0); // 右值 push_back 与扩容都只移动
+        EXPECT_GT(Item::moves, 1000);
+        v.insert(v.begin(), 2, v[999]);
+        v.erase(v.begin());
+        EXPECT_EQ(v[0].value, "999");
+        EXPECT_EQ(v[1].value, "0");
+        EXPECT_EQ(v[1000].value, "999");
+    }
+
+    Item::reset();
+    Tiny::list<Item> items;
+    items.push_back(Item("a"));
+    items.push_front(Item("b"));
+    EXPECT_EQ(Item::copies, 0);
+    EXPECT_EQ(items.front().value, "b");
+
+    Tiny::deque<std::string> strings;
+    for (int i = 0; i < 2000; ++i)
+        strings.push_back(std::to_string(i));
+    strings.insert(strings.begin() + 10, "x");
+    EXPECT_EQ(strings[10], "x");
+    EXPECT_EQ(strings[11], "10");
+    EXPECT_EQ(strings[2000], "1999");
+}
+
+// 测试流式填充与拷贝：各指令集级别、各元素大小、未对齐的起点与不足一个向量的长度都与逐字节结果一致
+TEST(SimdMemopsTest, StreamFillAndCopy)
+{
+    std::vector<simd_level> levels = {simd_level::scalar};
+    if (cpu_simd_level() >= simd_level::sse2)
+        levels.push_back(simd_level::sse2);
+    if (cpu_simd_level() >= simd_level::avx2)
+        levels.push_back(simd_level::avx2);
+
+    unsigned char value[32];
+    for (int i = 0; i < 32; ++i)
+        value[i] = static_cast<unsigned char>(i * 7 + 1);
+    std::vector<unsigned char> src(4096 + 64);
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] = static_cast<unsigned char>(i * 31);
+
+    for (const simd_level level : levels)
+    {
+        for (const size_t size : {1, 2, 4, 8, 16, 32})
+        {
+            for (const size_t offset : {0, 1, 3, 8, 17})
+            {
+                for (const size_t count : {0, 1, 5, 100, 4096 / 32})
+                {
+                    std::vector<unsigned char> buffer(4096 + 64, 0xee);
+                    stream_fill(buffer.data() + offset, value, size, count, level);
+                    for (size_t i = 0; i < buffer.size(); ++i)
+                    {
+                        const bool inside = i >= offset && i < offset + size * count;
+                        ASSERT_EQ(buffer[i], inside ? value[(i - offset) % size] : 0xee)
+                            << "level " << static_cast<int>(level) << " size " << size << " offset " << offset;
+                    }
+                }
+            }
+        }
+        for (const size_t offset : {0, 5, 32})
+        {
+            for (const size_t bytes : {0, 7, 31, 129, 4000})
+            {
+                std::vector<unsigned char> buffer(4096 + 64, 0xee);
+                stream_copy(buffer.data() + offset, src.data() + 3, bytes, level);
+                ASSERT_EQ(0, std::memcmp(buffer.data() + offset, src.data() + 3, bytes));
+                ASSERT_EQ(buffer[offset + bytes], 0xee);
+            }
+        }
+    }
+
+    // 超过阈值的 vector<float> 初始化与拷贝走流式路径
+    const size_t n = 2 * STREAMING_THRESHOLD / sizeof(float) + 3;
+    Tiny::vector<float> floats(n, 1.5f);
+    EXPECT_EQ(floats[0], 1.5f);
+    EXPECT_EQ(floats[n - 1], 1.5f);
+    auto* copy = static_cast<float*>(malloc_alloc::allocate(n * sizeof(float)));
+    Tiny::uninitialized_copy(floats.begin(), floats.end(), copy);
+    EXPECT_EQ(copy[n / 2], 1.5f);
+    EXPECT_EQ(copy[n - 1], 1.5f);
+    malloc_alloc::deallocate(copy, n * sizeof(float));
+}
+
 // // 综合测试：STL容器使用分配器
 // TEST(IntegrationTest, VectorWithAllocator)
 // {
@@ -242,6 +1166,483 @@ TEST(UninitializedMemoryTest, Fill)
 //     }
 // }
 
+// 测试批量接口：池化请求整批取出的块互不重叠且满足对齐，释放后可再次整批取回，统计与逐块分配一致
+template <typename Pool>
+void check_batch_alloc()
+{
+    constexpr size_t count = 1000;
+    std::vector<void*> blocks(count);
+    for (const size_t n : {8, 24, 128, 1000})
+    {
+        Pool::allocate_batch(n, count, blocks.data());
+        std::vector<void*> sorted(blocks);
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t i = 0; i < count; ++i)
+        {
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(sorted[i]) % Pool::ALIGN, 0u);
+            if (i + 1 < count)
+            {
+                ASSERT_LE(static_cast<char*>(sorted[i]) + n, sorted[i + 1]) << "n = " << n;
+            }
+            std::memset(sorted[i], 0x5a, n);
+        }
+        Pool::deallocate_batch(n, count, blocks.data());
+        Pool::allocate_batch(n, count / 2, blocks.data());
+        Pool::deallocate_batch(n, count / 2, blocks.data());
+    }
+}
+
+TEST(BatchAllocTest, PoolBatches)
+{
+    check_batch_alloc<default_alloc_template<false, 10>>();
+    check_batch_alloc<default_alloc_template<true, 10>>();
+    check_batch_alloc<numa_alloc<2>>();
+
+    if (alloc_stats_enabled && !alloc_hardened_enabled)
+    {
+        using Pool = default_alloc_template<false, 11>;
+        void* blocks[300];
+        Pool::allocate_batch(32, 300, blocks);
+        auto s = Pool::stats();
+        EXPECT_EQ(s.allocations[3], 300u);
+        EXPECT_EQ(s.refills, 0u); // 直接从内存池切分，不经过 refill
+        Pool::deallocate_batch(32, 300, blocks);
+        s = Pool::stats();
+        EXPECT_EQ(s.deallocations[3], 300u);
+        EXPECT_EQ(s.free_list_bytes + s.pool_bytes, s.heap_size);
+    }
+}
+
+// 测试 simple_alloc 的批量接口：没有批量接口的分配策略逐块分配
+TEST(BatchAllocTest, SimpleAllocFallsBack)
+{
+    static_assert(has_batch_alloc<alloc>::value && has_batch_alloc<malloc_alloc>::value);
+    static_assert(!has_batch_alloc<arena_alloc<>>::value);
+    int* blocks[100];
+    simple_alloc<int, malloc_alloc>::allocate_batch(4, 100, blocks);
+    simple_alloc<int, malloc_alloc>::deallocate_batch(4, 100, blocks);
+    simple_alloc<int, arena_alloc<>>::allocate_batch(4, 100, blocks);
+    for (int* p : blocks)
+        p[3] = 1;
+    simple_alloc<int, arena_alloc<>>::deallocate_batch(4, 100, blocks);
+}
+
+/** 第 limit 次拷贝时抛出异常 */
+struct ThrowOnCopy
+{
+    static inline int copies = 0;
+    static inline int limit = -1;
+    static inline int alive = 0;
+    int value;
+
+    explicit ThrowOnCopy(const int v) : value(v)
+    {
+        ++alive;
+    }
+
+    ThrowOnCopy(const ThrowOnCopy& other) : value(other.value)
+    {
+        if (++copies == limit)
+            throw std::runtime_error("copy");
+        ++alive;
+    }
+
+    ~ThrowOnCopy()
+    {
+        --alive;
+    }
+};
+
+// 测试按批分配节点的 list 构造、插入与 deque 构造，以及插入中途抛出异常时的回滚
+TEST(BatchAllocTest, ContainersUseBatches)
+{
+    list<int> filled(1000, 7);
+    EXPECT_EQ(filled.size(), 1000u);
+    EXPECT_EQ(filled.back(), 7);
+
+    std::vector<int> src(150);
+    for (int i = 0; i < 150; ++i)
+        src[i] = i;
+    list<int, mt_alloc> l(src.begin(), src.end());
+    l.insert(l.begin(), 3, -1);
+    auto it = l.insert(++l.begin(), src.begin(), src.begin() + 70);
+    EXPECT_EQ(*it, 0);
+    EXPECT_EQ(l.size(), 223u);
+    EXPECT_EQ(l.front(), -1);
+    EXPECT_EQ(l.back(), 149);
+
+    deque<std::string> d(5000, std::string(40, 'x'));
+    EXPECT_EQ(d.size(), 5000u);
+    EXPECT_EQ(d[4999], std::string(40, 'x'));
+
+    {
+        list<ThrowOnCopy> target;
+        target.push_back(ThrowOnCopy(1));
+        std::vector<ThrowOnCopy> values(200, ThrowOnCopy(2));
+        ThrowOnCopy::copies = 0;
+        ThrowOnCopy::limit = 100; // 第二批的中间
+        EXPECT_THROW(target.insert(target.end(), values.begin(), values.end()), std::runtime_error);
+        EXPECT_EQ(target.size(), 1u); // 已插入的节点全部撤销
+        ThrowOnCopy::copies = 0;
+        EXPECT_THROW((list<ThrowOnCopy>(150, ThrowOnCopy(3))), std::runtime_error);
+        ThrowOnCopy::limit = -1;
+    }
+    EXPECT_EQ(ThrowOnCopy::alive, 0);
+}
+
+// 测试 list 与 deque 的拷贝、移动与交换：副本各自拥有节点，析构时不会重复释放
+TEST(BatchAllocTest, ContainersCopyAndMove)
+{
+    list<std::string> l;
+    deque<std::string> d;
+    for (int i = 0; i < 1500; ++i)
+    {
+        l.push_back(std::to_string(i));
+        d.push_back(std::to_string(i));
+    }
+
+    list<std::string> lc(l);
+    deque<std::string> dc(d);
+    lc.front() = "copy";
+    dc[0] = "copy";
+    EXPECT_EQ(l.front(), "0");
+    EXPECT_EQ(d[0], "0");
+    EXPECT_EQ(lc.size(), 1500u);
+    EXPECT_EQ(dc.size(), 1500u);
+    EXPECT_EQ(dc[1499], "1499");
+
+    list<std::string> ls(3, "short");
+    deque<std::string> ds(3, "short");
+    ls = l; // 目标较短
+    ds = d;
+    EXPECT_EQ(ls.size(), 1500u);
+    EXPECT_EQ(ls.back(), "1499");
+    EXPECT_EQ(ds.size(), 1500u);
+    EXPECT_EQ(ds[1499], "1499");
+    ls = list<std::string>(2, "long"); // 目标较长
+    EXPECT_EQ(ls.size(), 2u);
+    EXPECT_EQ(ls.back(), "long");
+    ls = ls;
+    ds = ds;
+    EXPECT_EQ(ls.size(), 2u);
+    EXPECT_EQ(ds.size(), 1500u);
+
+    list<std::string> lm(std::move(lc));
+    deque<std::string> dm(std::move(dc));
+    EXPECT_TRUE(lc.empty());
+    EXPECT_TRUE(dc.empty());
+    EXPECT_EQ(lm.front(), "copy");
+    EXPECT_EQ(dm[0], "copy");
+    lc.push_back("reused"); // 被移走的容器仍可使用
+    dc.push_back("reused");
+    EXPECT_EQ(lc.back(), "reused");
+    EXPECT_EQ(dc.back(), "reused");
+
+    ls = std::move(lm);
+    ds = std::move(dm);
+    EXPECT_TRUE(lm.empty());
+    EXPECT_TRUE(dm.empty());
+    EXPECT_EQ(ls.size(), 1500u);
+    EXPECT_EQ(ds.front(), "copy");
+
+    swap(ls, l);
+    swap(ds, d);
+    EXPECT_EQ(ls.front(), "0");
+    EXPECT_EQ(d.front(), "copy");
+
+    // deque 填充构造中途抛出异常：已构造的元素全部析构
+    ThrowOnCopy::copies = 0;
+    ThrowOnCopy::limit = 700; // 跨过若干个缓冲区
+    EXPECT_THROW((deque<ThrowOnCopy>(1000, ThrowOnCopy(4))), std::runtime_error);
+    ThrowOnCopy::limit = -1;
+    EXPECT_EQ(ThrowOnCopy::alive, 0);
+}
+
+// 测试一级配置器 reallocate 失败时原区块仍然有效，其采样记录不被提前删除
+TEST(HeapProfilerTest, FailedReallocKeepsSample)
+{
+    if (!heap_profiler_enabled)
+        GTEST_SKIP() << "TINY_STL_HEAP_PROFILER=0";
+    heap_profiler::reset();
+    heap_profiler::set_sample_interval(1);
+
+    void* p = malloc_alloc::allocate(4096);
+    EXPECT_EQ(heap_profiler::live_sampled_bytes(), 4096u);
+    EXPECT_THROW(malloc_alloc::reallocate(p, 4096, static_cast<size_t>(-1) / 2), std::bad_alloc);
+    EXPECT_EQ(heap_profiler::live_sampled_bytes(), 4096u);
+    p = malloc_alloc::reallocate(p, 4096, 8192);
+    EXPECT_EQ(heap_profiler::live_sampled_bytes(), 8192u);
+    malloc_alloc::deallocate(p, 8192);
+    EXPECT_EQ(heap_profiler::live_sampled_bytes(), 0u);
+    heap_profiler::set_sample_interval(0);
+}
+
+// 测试采样堆分析器：间隔为 1 字节时每次分配都被采样，释放后存活字节归零，画像符合 heap_v2 格式
+TEST(HeapProfilerTest, TracksLiveBytesPerSite)
+{
+    if (!heap_profiler_enabled)
+        GTEST_SKIP() << "TINY_STL_HEAP_PROFILER=0";
+    using Pool = default_alloc_template<false, 9>;
+    heap_profiler::reset();
+    heap_profiler::set_sample_interval(1);
+
+    std::vector<void*> small;
+    for (int i = 0; i < 100; ++i)
+        small.push_back(Pool::allocate(24));
+    void* large = Pool::allocate(4096); // 经一级配置器，只采样一次
+    {
+        vector<int, Pool> v;
+        for (int i = 0; i < 1000; ++i)
+            v.push_back(i);
+        EXPECT_GE(heap_profiler::live_sampled_bytes(), 100 * 24 + 4096 + 1000 * sizeof(int));
+    }
+    EXPECT_EQ(heap_profiler::live_sampled_bytes(), 100u * 24 + 4096);
+
+    FILE* f = std::tmpfile();
+    ASSERT_NE(f, nullptr);
+    ASSERT_TRUE(heap_profiler::dump(f));
+    std::rewind(f);
+    char line[256];
+    ASSERT_NE(std::fgets(line, sizeof(line), f), nullptr);
+    EXPECT_NE(std::strstr(line, "heap profile: "), nullptr);
+    EXPECT_NE(std::strstr(line, "@ heap_v2/1"), nullptr);
+    ASSERT_NE(std::fgets(line, sizeof(line), f), nullptr);
+    EXPECT_NE(std::strstr(line, "] @ 0x"), nullptr);
+    std::fclose(f);
+
+    heap_profiler::set_sample_interval(0);
+    for (void* p : small)
+        Pool::deallocate(p, 24);
+    Pool::deallocate(large, 4096);
+    EXPECT_EQ(heap_profiler::live_sampled_bytes(), 0u);
+    size_t sampled = 0;
+    for (const auto& site : heap_profiler::sites())
+        sampled += site.alloc_count;
+    EXPECT_GE(sampled, 101u);
+
+    // 关闭后不再采样
+    void* p = Pool::allocate(24);
+    Pool::deallocate(p, 24);
+    size_t after = 0;
+    for (const auto& site : heap_profiler::sites())
+        after += site.alloc_count;
+    EXPECT_EQ(after, sampled);
+    heap_profiler::reset();
+}
+
+// 测试采样率：平均间隔为 64 KiB 时，采样次数与总字节数 / 间隔相当
+TEST(HeapProfilerTest, SamplingRate)
+{
+    if (!heap_profiler_enabled)
+        GTEST_SKIP() << "TINY_STL_HEAP_PROFILER=0";
+    using Pool = default_alloc_template<false, 9>;
+    heap_profiler::reset();
+    heap_profiler::set_sample_interval(64 * 1024);
+    for (int i = 0; i < 200000; ++i)
+        Pool::deallocate(Pool::allocate(64), 64);
+    heap_profiler::set_sample_interval(0);
+    size_t sampled = 0;
+    for (const auto& site : heap_profiler::sites())
+        sampled += site.alloc_count;
+    // 期望 200000 * 64 / 65536 ≈ 195 次
+    EXPECT_GT(sampled, 120u);
+    EXPECT_LT(sampled, 280u);
+    EXPECT_EQ(heap_profiler::live_sampled_bytes(), 0u);
+    heap_profiler::reset();
+}
+
+namespace
+{
+    /**
+     * @brief 记录构造与析构次数的连接对象
+     */
+    struct Connection
+    {
+        static inline int constructed = 0;
+        static inline int destroyed = 0;
+
+        explicit Connection(const int fd = -1, const bool fail = false) : fd(fd)
+        {
+            if (fail)
+                throw std::runtime_error("connect failed");
+            ++constructed;
+            buffer.reserve(256);
+        }
+
+        ~Connection()
+        {
+            ++destroyed;
+        }
+
+        int fd;
+        std::string buffer;
+    };
+}
+
+// 测试对象池：归还的槽位被复用，统计计数与二级配置器的字段一致
+TEST(ObjectPoolTest, CreateDestroyReuse)
+{
+    using Pool = object_pool<Connection>;
+    Connection::constructed = Connection::destroyed = 0;
+    std::vector<Connection*> conns;
+    for (int i = 0; i < 100; ++i)
+        conns.push_back(Pool::create(i));
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(conns[i]->fd, i);
+    std::vector<Connection*> freed = conns;
+    for (auto c : conns)
+        Pool::destroy(c);
+    EXPECT_EQ(Connection::destroyed, 100);
+    Pool::destroy(nullptr);
+
+    Connection* c = Pool::create(7);
+    EXPECT_NE(std::find(freed.begin(), freed.end(), c), freed.end());
+    EXPECT_EQ(c->fd, 7);
+    Pool::destroy(c);
+
+    // 构造函数抛出异常时槽位退回池中
+    EXPECT_THROW(Pool::create(1, true), std::runtime_error);
+    if (alloc_stats_enabled)
+    {
+        const auto st = Pool::stats();
+        EXPECT_EQ(st.allocations[0], 102u);
+        EXPECT_EQ(st.deallocations[0], 102u);
+        EXPECT_EQ(st.live_objects, 0u);
+        EXPECT_GE(st.chunk_allocs, 1u);
+        EXPECT_GE(st.refills, 4u);
+        EXPECT_LE(st.free_list_bytes + st.thread_cache_bytes + st.pool_bytes, st.heap_size);
+    }
+}
+
+// 测试保留构造状态：归还时不析构，再次取出的是同一个对象，内部缓冲保持不变
+TEST(ObjectPoolTest, KeepConstructed)
+{
+    using Pool = object_pool<Connection, true>;
+    Connection::constructed = Connection::destroyed = 0;
+    Connection* c = Pool::create(3);
+    c->buffer = "GET / HTTP/1.1";
+    const size_t capacity = c->buffer.capacity();
+    Pool::destroy(c);
+    EXPECT_EQ(Connection::destroyed, 0);
+
+    Connection* d = Pool::create(4);
+    EXPECT_EQ(d, c);
+    EXPECT_EQ(Connection::constructed, 1);
+    EXPECT_EQ(d->fd, 3); // 复用的对象忽略实参，由调用方重置
+    EXPECT_EQ(d->buffer.capacity(), capacity);
+    d->buffer.clear();
+
+    Connection* e = Pool::create(5); // 新槽位照常构造
+    EXPECT_EQ(e->fd, 5);
+    EXPECT_EQ(Connection::constructed, 2);
+    Pool::destroy(d);
+    Pool::destroy(e);
+}
+
+// 测试容量上限：try_create 立即失败，create 阻塞到有对象归还
+TEST(ObjectPoolTest, BoundedCapacity)
+{
+    using Pool = object_pool<Connection, false, 1>;
+    EXPECT_EQ(Pool::set_capacity(2), 0u);
+    Connection* a = Pool::try_create(1);
+    ASSERT_NE(a, nullptr);
+    EXPECT_THROW(Pool::create(2, true), std::runtime_error); // 构造失败不会泄漏配额
+    Connection* b = Pool::try_create(2);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(Pool::try_create(3), nullptr);
+    EXPECT_EQ(Pool::try_create(3), nullptr);
+
+    std::atomic<bool> created{false};
+    std::thread waiter([&]
+    {
+        Connection* c = Pool::create(3);
+        created = true;
+        Pool::destroy(c);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(created);
+    Pool::destroy(a);
+    waiter.join();
+    EXPECT_TRUE(created);
+    Pool::destroy(b);
+
+    const auto st = Pool::stats();
+    EXPECT_EQ(st.capacity, 2u);
+    EXPECT_EQ(st.live_objects, 0u);
+    if (alloc_stats_enabled)
+    {
+        EXPECT_EQ(st.rejected_creates, 2u);
+        EXPECT_EQ(st.blocked_creates, 1u);
+    }
+}
+
+// 测试多线程：对象可在任意线程归还，线程退出后计数并入全局计数
+TEST(ObjectPoolTest, CrossThreadRecycling)
+{
+    using Pool = object_pool<std::pair<long, long>, false, 2>;
+    Pool::set_capacity(1000);
+    constexpr int THREADS = 4;
+    constexpr int ROUNDS = 20000;
+    std::vector<Pool::value_type*> handoff[THREADS];
+    std::mutex handoff_mutex[THREADS];
+    std::atomic<int> finished{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            auto drain = [&]
+            {
+                std::vector<Pool::value_type*> mine;
+                {
+                    std::lock_guard<std::mutex> lock(handoff_mutex[t]);
+                    mine.swap(handoff[t]);
+                }
+                for (auto q : mine)
+                    Pool::destroy(q);
+            };
+            for (int i = 0; i < ROUNDS; ++i)
+            {
+                // 满额时先归还别的线程交来的对象再重试，而不是阻塞等待
+                Pool::value_type* p;
+                while (nullptr == (p = Pool::try_create(t, i)))
+                {
+                    drain();
+                    std::this_thread::yield();
+                }
+                EXPECT_EQ(p->first, t);
+                {
+                    std::lock_guard<std::mutex> lock(handoff_mutex[(t + 1) % THREADS]);
+                    handoff[(t + 1) % THREADS].push_back(p);
+                }
+                drain();
+            }
+            // 其他线程还可能交来对象，全部结束前继续归还
+            ++finished;
+            while (finished < THREADS)
+            {
+                drain();
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+    for (auto& h : handoff)
+    {
+        for (auto q : h)
+            Pool::destroy(q);
+    }
+    const auto st = Pool::stats();
+    EXPECT_EQ(st.live_objects, 0u);
+    if (alloc_stats_enabled)
+    {
+        EXPECT_EQ(st.allocations[0], static_cast<size_t>(THREADS * ROUNDS));
+        EXPECT_EQ(st.deallocations[0], static_cast<size_t>(THREADS * ROUNDS));
+        EXPECT_LE(st.heap_size, 2 * Pool::CHUNK_BYTES + 1024); // 配额限制住了池的规模
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
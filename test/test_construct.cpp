@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <string>
+#include <utility>
 #include "allocator/construct.hpp"
 
 using namespace Tiny;
@@ -98,6 +100,24 @@ TEST(TinySTLConstructTest, TestDestroyCharTypes)
     EXPECT_TRUE(true); // 空操作不会失败
 }
 
+// 测试类型萃取：由 std::is_trivially_* 计算，用户结构体与 std::pair 无需手写特化
+TEST(TinySTLConstructTest, TestTypeTraits)
+{
+    struct Point
+    {
+        int x;
+        int y;
+    };
+
+    static_assert(std::is_same<type_traits<Point>::is_POD_type, true_type>::value);
+    static_assert(std::is_same<type_traits<std::pair<int, int>>::is_POD_type, true_type>::value);
+    static_assert(std::is_same<type_traits<TestObject>::has_trivial_destructor, true_type>::value);
+    static_assert(std::is_same<type_traits<double*>::is_POD_type, true_type>::value);
+    static_assert(std::is_same<type_traits<std::string>::is_POD_type, false_type>::value);
+    static_assert(std::is_same<type_traits<std::string>::has_trivial_destructor, false_type>::value);
+    EXPECT_TRUE((std::is_same<type_traits<long double>::has_trivial_copy_constructor, true_type>::value));
+}
+
 
 int main(int argc, char** argv)
 {
@@ -1,4 +1,5 @@
 #include "utility/ThreadPool.h"
+#include "allocator/numa.hpp"
 #include <gtest/gtest.h>
 #include <atomic>
 #include <chrono>
@@ -140,6 +141,27 @@ namespace Tiny
         EXPECT_EQ(init_count, 3);
     }
 
+    // 工作线程轮流固定到各 NUMA 节点，并从本地节点的池分配内存
+    TEST_F(ThreadPoolTest, NumaPinnedWorkers)
+    {
+        pool->setThreadInitCallback(numa_worker_init());
+        pool->start(4);
+
+        std::vector<std::future<bool>> results;
+        for (int i = 0; i < 16; ++i)
+        {
+            results.push_back(pool->submitTask([]
+            {
+                void* p = numa_alloc<>::allocate(64);
+                numa_alloc<>::deallocate(p, 64);
+                return numa_thread_node() >= 0 &&
+                       numa_current_node() < numa_topology::node_count();
+            }));
+        }
+        for (auto& r : results)
+            EXPECT_TRUE(r.get());
+    }
+
     // 并发任务提交
     TEST_F(ThreadPoolTest, ConcurrentSubmission)
     {
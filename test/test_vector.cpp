@@ -1,4 +1,11 @@
 #include <gtest/gtest.h>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "container/small_vector.hpp"
 #include "container/vector.hpp"
 
 namespace Tiny
@@ -217,26 +224,504 @@ namespace Tiny
         }
     }
 
-    // // 测试自定义类型
-    // TEST(VectorTest, CustomType)
-    // {
-    //     struct Point
-    //     {
-    //         int x, y;
-    //
-    //         Point(int x = 0, int y = 0) : x(x), y(y)
-    //         {
-    //         }
-    //     };
-    //
-    //     vector<Point> points;
-    //     points.emplace_back(1, 2);
-    //     points.push_back(Point(3, 4));
-    //
-    //     EXPECT_EQ(points.size(), 2);
-    //     EXPECT_EQ(points[0].x, 1);
-    //     EXPECT_EQ(points[1].y, 4);
-    // }
+    // 测试自定义类型
+    TEST(VectorTest, CustomType)
+    {
+        struct Point
+        {
+            int x, y;
+
+            Point(int x = 0, int y = 0) : x(x), y(y)
+            {
+            }
+        };
+
+        vector<Point> points;
+        points.emplace_back(1, 2);
+        points.push_back(Point(3, 4));
+
+        EXPECT_EQ(points.size(), 2);
+        EXPECT_EQ(points[0].x, 1);
+        EXPECT_EQ(points[1].y, 4);
+    }
+
+    /**
+     * @brief 统计拷贝与移动次数的元素；NoexceptMove 为 false 时移动构造可能抛出，扩容只能拷贝
+     */
+    template <bool NoexceptMove>
+    struct Tracked
+    {
+        static inline int copies = 0;
+        static inline int moves = 0;
+        static inline int throw_after = -1; ///< 再拷贝这么多次后抛出异常，-1 表示不抛出
+
+        std::string value;
+
+        explicit Tracked(std::string v = "") : value(std::move(v))
+        {
+        }
+
+        Tracked(const Tracked& other) : value(other.value)
+        {
+            if (throw_after == 0)
+                throw std::runtime_error("copy failed");
+            if (throw_after > 0)
+                --throw_after;
+            ++copies;
+        }
+
+        Tracked(Tracked&& other) noexcept(NoexceptMove) : value(std::move(other.value))
+        {
+            ++moves;
+        }
+
+        Tracked& operator=(const Tracked&) = default;
+
+        Tracked& operator=(Tracked&&) = default;
+
+        static void reset()
+        {
+            copies = moves = 0;
+            throw_after = -1;
+        }
+    };
+
+    // 测试右值插入与原地构造：不产生拷贝，noexcept 移动的元素扩容时被移动
+    TEST(VectorTest, MoveAwareInsertion)
+    {
+        using T = Tracked<true>;
+        T::reset();
+        vector<T> v;
+        for (int i = 0; i < 100; ++i)
+        {
+            if (i % 2 == 0)
+                v.emplace_back(std::to_string(i));
+            else
+                v.push_back(T(std::to_string(i)));
+        }
+        v.emplace(v.begin() + 50, "middle");
+        v.insert(v.begin(), T("front"));
+        EXPECT_EQ(T::copies, 0);
+        EXPECT_GT(T::moves, 0);
+        ASSERT_EQ(v.size(), 102);
+        EXPECT_EQ(v[0].value, "front");
+        EXPECT_EQ(v[51].value, "middle");
+        EXPECT_EQ(v[101].value, "99");
+
+        // 插入自身元素的引用，扩容后仍得到原值
+        vector<std::string> s(1, "self");
+        s.shrink_to_fit();
+        s.push_back(s[0]);
+        s.emplace(s.begin(), s[1]);
+        EXPECT_EQ(s[0], "self");
+        EXPECT_EQ(s[2], "self");
+    }
+
+    // 测试强异常保证：移动可能抛出时扩容改用拷贝，拷贝中途失败则容器保持原样
+    TEST(VectorTest, StrongGuaranteeOnGrowth)
+    {
+        using T = Tracked<false>;
+        T::reset();
+        vector<T> v;
+        v.reserve(4);
+        for (int i = 0; i < 4; ++i)
+            v.emplace_back(std::to_string(i));
+        T* data = &v[0];
+
+        T::throw_after = 2;
+        EXPECT_THROW(v.push_back(T("4")), std::runtime_error);
+        ASSERT_EQ(v.size(), 4);
+        EXPECT_EQ(v.capacity(), 4);
+        EXPECT_EQ(&v[0], data);
+        for (int i = 0; i < 4; ++i)
+            EXPECT_EQ(v[i].value, std::to_string(i));
+
+        T::throw_after = 1;
+        EXPECT_THROW(v.reserve(100), std::runtime_error);
+        EXPECT_EQ(v.capacity(), 4);
+        EXPECT_EQ(v[3].value, "3");
+        T::reset();
+    }
+
+    // 测试拷贝赋值、移动赋值与 reserve / shrink_to_fit
+    TEST(VectorTest, AssignmentReserveShrink)
+    {
+        vector<std::string> a(3, "a");
+        vector<std::string> b(10, "b");
+        a = b;
+        EXPECT_EQ(a.size(), 10);
+        EXPECT_EQ(a[9], "b");
+        b = vector<std::string>(2, "c");
+        EXPECT_EQ(b.size(), 2);
+        EXPECT_EQ(b[1], "c");
+
+        const std::string* data = &a[0];
+        vector<std::string> c;
+        c = std::move(a);
+        EXPECT_EQ(&c[0], data);
+        EXPECT_TRUE(a.empty());
+        EXPECT_EQ(a.capacity(), 0);
+
+        c.reserve(100);
+        EXPECT_EQ(c.capacity(), 100);
+        EXPECT_EQ(c[0], "b");
+        c.erase(c.begin() + 2, c.end());
+        c.shrink_to_fit();
+        EXPECT_EQ(c.capacity(), 2);
+        EXPECT_EQ(c[1], "b");
+        swap(b, c);
+        EXPECT_EQ(b[0], "b");
+        EXPECT_EQ(c[0], "c");
+    }
+
+    // 测试可按字节搬迁类型的扩容：大块经由一级配置器的 realloc，中间插入后元素顺序正确
+    TEST(VectorTest, RelocatableGrowth)
+    {
+        struct Sample
+        {
+            int id;
+            double value;
+        };
+        static_assert(is_trivially_relocatable<Sample>::value);
+        static_assert(!is_trivially_relocatable<std::string>::value);
+
+        const size_t reallocs_before = malloc_alloc::stats().reallocations;
+        vector<Sample> v;
+        for (int i = 0; i < 10000; ++i)
+            v.push_back(Sample{i, i * 0.5});
+        if (alloc_stats_enabled)
+        {
+            EXPECT_GT(malloc_alloc::stats().reallocations, reallocs_before);
+        }
+
+        v.insert(v.begin() + 1, 3, Sample{-1, 0});
+        ASSERT_EQ(v.size(), 10003);
+        EXPECT_EQ(v[0].id, 0);
+        EXPECT_EQ(v[3].id, -1);
+        EXPECT_EQ(v[4].id, 1);
+        for (int i = 1; i < 10000; ++i)
+            ASSERT_EQ(v[i + 3].id, i);
+
+        // 插入的值引用自身元素，扩容后仍应得到原值
+        vector<int> ints(4, 9);
+        ints.insert(ints.begin(), 100, ints[3]);
+        ints.push_back(ints[0]);
+        EXPECT_EQ(ints.size(), 105);
+        EXPECT_EQ(ints[0], 9);
+        EXPECT_EQ(ints[104], 9);
+    }
+
+    /**移动与析构平凡、拷贝构造可能抛出：仍可按字节搬迁，但不能先腾出空位再拷贝*/
+    struct FragileCopy
+    {
+        static inline int budget = -1;
+        int id;
+
+        explicit FragileCopy(int i) : id(i) {}
+
+        FragileCopy(const FragileCopy &other) : id(other.id)
+        {
+            if (budget >= 0 && budget-- == 0)
+                throw std::runtime_error("copy");
+        }
+
+        FragileCopy(FragileCopy &&) = default;
+        FragileCopy &operator=(const FragileCopy &) = default;
+        FragileCopy &operator=(FragileCopy &&) = default;
+    };
+
+    // 测试可搬迁类型扩容插入时拷贝抛出异常：vector 保持原样，不会留下未构造的空位
+    TEST(VectorTest, RelocatableInsertThrows)
+    {
+        static_assert(is_trivially_relocatable<FragileCopy>::value);
+        vector<FragileCopy> v;
+        for (int i = 0; i < 8; ++i)
+            v.push_back(FragileCopy(i));
+        v.shrink_to_fit();
+        ASSERT_EQ(v.capacity(), v.size());
+
+        FragileCopy::budget = 2;
+        EXPECT_THROW(v.insert(v.begin() + 3, 5, FragileCopy(-1)), std::runtime_error);
+        FragileCopy::budget = 0;
+        const FragileCopy extra(-2);
+        EXPECT_THROW(v.insert(v.begin() + 3, extra), std::runtime_error);
+        FragileCopy::budget = -1;
+        ASSERT_EQ(v.size(), 8);
+        for (int i = 0; i < 8; ++i)
+            EXPECT_EQ(v[i].id, i);
+
+        v.insert(v.begin() + 3, 2, FragileCopy(-1));
+        ASSERT_EQ(v.size(), 10);
+        EXPECT_EQ(v[3].id, -1);
+        EXPECT_EQ(v[5].id, 3);
+    }
+
+    // 测试扩容策略：各策略的容量序列、按页取整、按分配器实际块大小计入容量、max_size 上限
+    TEST(VectorTest, GrowthPolicy)
+    {
+        constexpr size_t max = static_cast<size_t>(-1) / 8;
+        EXPECT_EQ(growth_2x::next_capacity(0, 1, 8, max), 1);
+        EXPECT_EQ(growth_2x::next_capacity(100, 101, 8, max), 200);
+        EXPECT_EQ(growth_2x::next_capacity(100, 350, 8, max), 350);
+        EXPECT_EQ(growth_1_5x::next_capacity(1, 2, 8, max), 2);
+        EXPECT_EQ(growth_1_5x::next_capacity(100, 101, 8, max), 150);
+        EXPECT_EQ(growth_1_5x::next_capacity(max - 1, max, 8, max), max);
+
+        // 达到一页后按页取整，整页都计入容量
+        EXPECT_EQ((page_growth<>::next_capacity(10, 11, 8, max)), 15);
+        EXPECT_EQ((page_growth<>::next_capacity(1000, 1001, 8, max)), 12288 / 8);
+        EXPECT_EQ((page_growth<growth_2x>::next_capacity(1000, 1001, 12, max)), 24576 / 12);
+        // 达到 2 MiB 后按大页取整
+        EXPECT_EQ(huge_page_growth<>::next_capacity(200000, 200001, 8, max), 4u * 1024 * 1024 / 8);
+        EXPECT_EQ(huge_page_growth<>::next_capacity(1000, 1001, 8, max), 12288 / 8);
+
+        vector<double, alloc, growth_1_5x> v;
+        size_t last = 0;
+        for (int i = 0; i < 100000; ++i) {
+            v.push_back(i);
+            if (v.capacity() != last) {
+                // 每次扩容不超过 1.5 倍（小容量时池的块大小可能多给几个元素）
+                if (last >= 32) {
+                    EXPECT_LE(v.capacity(), last * 3 / 2);
+                }
+                last = v.capacity();
+            }
+        }
+        for (int i = 0; i < 100000; ++i)
+            ASSERT_EQ(v[i], i);
+
+        vector<char, alloc, page_growth<>> bytes;
+        bytes.insert(bytes.end(), 5000, 'x');
+        EXPECT_EQ(bytes.capacity(), 8192);
+
+        // 池化的请求按所属类别的块大小计入容量：1 个 char 取得 8 字节的块
+        vector<char> small;
+        small.push_back('a');
+        if (!alloc_hardened_enabled) {
+            EXPECT_EQ(small.capacity(), alloc::good_size(1));
+        }
+
+        vector<double> huge;
+        EXPECT_THROW(huge.insert(huge.end(), huge.max_size() + 1, 0.0), std::length_error);
+    }
+
+    /**
+     * @brief 二级配置器累计的分配次数
+     */
+    size_t pool_allocations()
+    {
+        const auto st = alloc::stats();
+        size_t total = st.large_allocations;
+        for (const size_t n : st.allocations)
+            total += n;
+        return total;
+    }
+
+    // 测试内嵌缓冲区：不超过 N 个元素时不经过分配器，超过后整体搬出，收缩时搬回
+    TEST(VectorTest, SmallVector)
+    {
+        const size_t before = pool_allocations();
+        small_vector<int, 8> v;
+        EXPECT_EQ(v.capacity(), 8);
+        for (int i = 0; i < 8; ++i)
+            v.push_back(i);
+        v.insert(v.begin(), 0, 1);
+        small_vector<int, 8> copy(v);
+        small_vector<int, 8> filled(5, 3);
+        if (alloc_stats_enabled) {
+            EXPECT_EQ(pool_allocations(), before);
+        }
+
+        v.push_back(8);
+        EXPECT_GT(v.capacity(), 8);
+        for (int i = 0; i < 9; ++i)
+            ASSERT_EQ(v[i], i);
+        EXPECT_EQ(copy.size(), 8);
+        EXPECT_EQ(copy[7], 7);
+
+        v.erase(v.begin() + 4, v.end());
+        v.shrink_to_fit();
+        EXPECT_EQ(v.capacity(), 8);
+        EXPECT_EQ(v[3], 3);
+
+        // 非平凡类型：内嵌与溢出两种状态之间的拷贝、移动与交换
+        small_vector<std::string, 2> a;
+        a.push_back("a");
+        small_vector<std::string, 2> b(3, "b");
+        small_vector<std::string, 2> moved(std::move(a));
+        EXPECT_TRUE(a.empty());
+        EXPECT_EQ(a.capacity(), 2);
+        ASSERT_EQ(moved.size(), 1);
+        EXPECT_EQ(moved[0], "a");
+
+        moved.swap(b);
+        ASSERT_EQ(moved.size(), 3);
+        ASSERT_EQ(b.size(), 1);
+        EXPECT_EQ(moved[2], "b");
+        EXPECT_EQ(b[0], "a");
+
+        a = std::move(moved);
+        EXPECT_EQ(a.size(), 3);
+        EXPECT_TRUE(moved.empty());
+        a = b;
+        ASSERT_EQ(a.size(), 1);
+        EXPECT_EQ(a[0], "a");
+        a.emplace(a.begin(), "x");
+        a.emplace_back("y");
+        ASSERT_EQ(a.size(), 3);
+        EXPECT_EQ(a[0], "x");
+        EXPECT_EQ(a[1], "a");
+        EXPECT_EQ(a[2], "y");
+        b.swap(b);
+        EXPECT_EQ(b[0], "a");
+    }
+
+    // 测试区间插入、赋值与追加：前向迭代器只扩容一次，输入迭代器逐个读取，非平凡类型不多拷贝
+    TEST(VectorTest, RangeInsertAssign)
+    {
+        int arr[1000];
+        for (int i = 0; i < 1000; ++i)
+            arr[i] = i;
+
+        vector<int> v;
+        v.insert(v.end(), arr, arr + 1000);
+        EXPECT_EQ(v.capacity(), 1000);
+        v.insert(v.begin() + 10, {-1, -2, -3});
+        ASSERT_EQ(v.size(), 1003);
+        EXPECT_EQ(v[9], 9);
+        EXPECT_EQ(v[10], -1);
+        EXPECT_EQ(v[12], -3);
+        EXPECT_EQ(v[13], 10);
+        EXPECT_EQ(v[1002], 999);
+
+        const std::list<int> source = {7, 8, 9};
+        vector<long> longs(source.begin(), source.end());
+        longs.append_range(source);
+        ASSERT_EQ(longs.size(), 6);
+        EXPECT_EQ(longs[3], 7);
+        longs.assign(arr, arr + 2);
+        ASSERT_EQ(longs.size(), 2);
+        EXPECT_EQ(longs[1], 1);
+        longs.assign(4, 5);
+        EXPECT_EQ(longs.size(), 4);
+        EXPECT_EQ(longs[3], 5);
+
+        // 单趟的输入迭代器
+        std::istringstream in("1 2 3 4");
+        vector<int> read((std::istream_iterator<int>(in)), std::istream_iterator<int>());
+        ASSERT_EQ(read.size(), 4);
+        EXPECT_EQ(read[3], 4);
+        std::istringstream more("8 9");
+        auto it = read.insert(read.begin() + 1, std::istream_iterator<int>(more), std::istream_iterator<int>());
+        EXPECT_EQ(*it, 8);
+        ASSERT_EQ(read.size(), 6);
+        EXPECT_EQ(read[0], 1);
+        EXPECT_EQ(read[2], 9);
+        EXPECT_EQ(read[3], 2);
+        std::istringstream fewer("5");
+        read.assign(std::istream_iterator<int>(fewer), std::istream_iterator<int>());
+        ASSERT_EQ(read.size(), 1);
+        EXPECT_EQ(read[0], 5);
+
+        // 非平凡类型：备用空间充足时源元素拷贝构造或赋值到位，不足时只扩容一次，每个源元素恰好拷贝一次
+        using T = Tracked<true>;
+        const std::vector<T> items = {T("a"), T("b"), T("c"), T("d")};
+        T::reset();
+        vector<T> tracked(items.begin(), items.end());
+        EXPECT_EQ(T::copies, 4);
+        tracked.reserve(16);
+        T::reset();
+        tracked.insert(tracked.begin() + 1, items.begin(), items.begin() + 2);
+        tracked.insert(tracked.begin() + 5, items.begin(), items.end());
+        EXPECT_LE(T::copies, 6);
+        ASSERT_EQ(tracked.size(), 10);
+        EXPECT_EQ(tracked[1].value, "a");
+        EXPECT_EQ(tracked[2].value, "b");
+        EXPECT_EQ(tracked[3].value, "b");
+        EXPECT_EQ(tracked[5].value, "a");
+        EXPECT_EQ(tracked[9].value, "d");
+        tracked.shrink_to_fit();
+        T::reset();
+        tracked.insert(tracked.begin(), items.begin(), items.end());
+        EXPECT_EQ(T::copies, 4);
+        ASSERT_EQ(tracked.size(), 14);
+        EXPECT_EQ(tracked[3].value, "d");
+        EXPECT_EQ(tracked[4].value, "a");
+        tracked.assign({T("x"), T("y")});
+        ASSERT_EQ(tracked.size(), 2);
+        EXPECT_EQ(tracked[1].value, "y");
+
+        small_vector<std::string, 4> words = {"a", "b"};
+        words.insert(words.end(), {"c", "d", "e"});
+        ASSERT_EQ(words.size(), 5);
+        EXPECT_EQ(words[4], "e");
+    }
+
+    // 测试默认初始化的 resize 与直接写入：已有内容保留，写入的个数计入大小，非平凡类型照常构造
+    TEST(VectorTest, DefaultInitAndWrite)
+    {
+        vector<unsigned char> buffer(4, 7);
+        buffer.resize_default_init(1 << 20);
+        ASSERT_EQ(buffer.size(), 1u << 20);
+        EXPECT_EQ(buffer[3], 7);
+        std::memset(&buffer[4], 1, buffer.size() - 4);
+        EXPECT_EQ(buffer[(1 << 20) - 1], 1);
+        buffer.resize_default_init(2);
+        EXPECT_EQ(buffer.size(), 2);
+
+        const char text[] = "hello world";
+        size_t written = buffer.reserve_and_write(64, [&text](unsigned char* p, size_t n)
+        {
+            EXPECT_GE(n, 64u);
+            std::memcpy(p, text, 5);
+            return 5;
+        });
+        EXPECT_EQ(written, 5);
+        ASSERT_EQ(buffer.size(), 7);
+        EXPECT_EQ(buffer[2], 'h');
+        EXPECT_EQ(buffer[6], 'o');
+
+        // 反复追加时按扩容策略增长，而不是每次恰好扩到所需大小
+        vector<int> ints;
+        size_t reallocations = 0;
+        size_t capacity = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            written = ints.reserve_and_write(3, [i](int* p, size_t)
+            {
+                p[0] = i;
+                p[1] = i + 1;
+                return 2;
+            });
+            EXPECT_EQ(written, 2);
+            if (ints.capacity() != capacity)
+            {
+                ++reallocations;
+                capacity = ints.capacity();
+            }
+        }
+        ASSERT_EQ(ints.size(), 2000);
+        EXPECT_EQ(ints[1998], 999);
+        EXPECT_EQ(ints[1999], 1000);
+        EXPECT_LT(reallocations, 20);
+
+        // writer 抛出异常时大小不变
+        EXPECT_THROW(ints.reserve_and_write(8, [](int*, size_t) -> size_t { throw std::runtime_error("read"); }),
+                     std::runtime_error);
+        EXPECT_EQ(ints.size(), 2000);
+
+        vector<std::string> strings(1, "keep");
+        strings.resize_default_init(3);
+        ASSERT_EQ(strings.size(), 3);
+        EXPECT_EQ(strings[0], "keep");
+        EXPECT_TRUE(strings[2].empty());
+
+        small_vector<char, 16> chars;
+        chars.resize_default_init(8);
+        EXPECT_EQ(chars.capacity(), 16);
+        chars.resize_default_init(100);
+        EXPECT_EQ(chars.size(), 100);
+    }
 
     // 测试交换功能
     TEST(VectorTest, Swap)